@@ -0,0 +1,292 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "BatchSolver.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// Optima includes
+#include <Optima/Exception.hpp>
+#include <Optima/Options.hpp>
+#include <Optima/Problem.hpp>
+#include <Optima/Result.hpp>
+#include <Optima/Sensitivity.hpp>
+#include <Optima/Solver.hpp>
+#include <Optima/State.hpp>
+
+namespace Optima {
+
+/// Return the default number of worker threads.
+auto defaultNumThreads() -> Index
+{
+    return std::max<Index>(std::thread::hardware_concurrency(), 1);
+}
+
+struct BatchSolver::Impl
+{
+    /// The range of batch items still to be processed by a worker.
+    struct WorkRange
+    {
+        std::mutex mutex; ///< The mutex protecting the range against concurrent pops and steals.
+        Index begin = 0;  ///< The index of the next batch item to be processed.
+        Index end = 0;    ///< The index past the last batch item to be processed.
+    };
+
+    Options options;                          ///< The options for the optimization calculations.
+    Index numthreads = 1;                     ///< The number of workers (the calling thread is worker 0).
+    std::vector<Solver> solvers;              ///< The solver of each worker, whose workspace is reused across problems and batches.
+    std::unique_ptr<WorkRange[]> ranges;      ///< The range of batch items assigned to each worker.
+    std::vector<std::exception_ptr> errors;   ///< The first exception thrown in each worker during the current batch.
+    std::vector<std::thread> threads;         ///< The background worker threads (numthreads - 1 of them).
+    std::function<void(Index, Index)> task;   ///< The task executed by a worker (first argument) for a batch item (second argument).
+    std::mutex mutex;                         ///< The mutex protecting the batch scheduling state below.
+    std::condition_variable cvstart;          ///< The condition variable used to signal workers that a new batch has started.
+    std::condition_variable cvdone;           ///< The condition variable used to signal the calling thread that all workers are done.
+    Index generation = 0;                     ///< The counter of batches started so far.
+    Index pending = 0;                        ///< The number of background workers still processing the current batch.
+    bool stopping = false;                    ///< The flag that indicates the background workers should terminate.
+
+    /// Construct a BatchSolver::Impl object with given number of worker threads.
+    Impl(Index nthreads)
+    : numthreads(std::max<Index>(nthreads, 1)), solvers(numthreads),
+      ranges(new WorkRange[numthreads]), errors(numthreads)
+    {}
+
+    /// Construct a copy of a BatchSolver::Impl object (the worker threads are not shared).
+    Impl(const Impl& other)
+    : Impl(other.numthreads)
+    {
+        setOptions(other.options);
+    }
+
+    /// Destroy this BatchSolver::Impl object after terminating the worker threads.
+    ~Impl()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cvstart.notify_all();
+        for(auto& thread : threads)
+            thread.join();
+    }
+
+    /// Set the options for the optimization calculations.
+    auto setOptions(const Options& opts) -> void
+    {
+        options = opts;
+        for(auto& solver : solvers)
+            solver.setOptions(options);
+    }
+
+    /// Pop the next batch item from the range of given worker.
+    auto pop(Index worker, Index& item) -> bool
+    {
+        auto& range = ranges[worker];
+        std::lock_guard<std::mutex> lock(range.mutex);
+        if(range.begin == range.end)
+            return false;
+        item = range.begin++;
+        return true;
+    }
+
+    /// Steal the back half of the remaining range of another worker.
+    auto steal(Index worker, Index& item) -> bool
+    {
+        for(Index k = 1; k < numthreads; ++k)
+        {
+            auto& victim = ranges[(worker + k) % numthreads];
+            Index begin = 0, end = 0;
+            {
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                const auto remaining = victim.end - victim.begin;
+                if(remaining == 0)
+                    continue;
+                end = victim.end;
+                begin = victim.end - (remaining + 1)/2;
+                victim.end = begin;
+            }
+            auto& range = ranges[worker];
+            std::lock_guard<std::mutex> lock(range.mutex);
+            range.begin = begin + 1;
+            range.end = end;
+            item = begin;
+            return true;
+        }
+        return false;
+    }
+
+    /// Process batch items until no worker has any item left.
+    auto process(Index worker) -> void
+    {
+        Index item = 0;
+        while(pop(worker, item) || steal(worker, item))
+        {
+            try { task(worker, item); }
+            catch(...) { if(!errors[worker]) errors[worker] = std::current_exception(); }
+        }
+    }
+
+    /// The main loop of a background worker thread.
+    auto run(Index worker) -> void
+    {
+        Index current = 0;
+        while(true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cvstart.wait(lock, [&] { return stopping || generation != current; });
+                if(stopping) return;
+                current = generation;
+            }
+
+            process(worker);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if(--pending == 0)
+                    cvdone.notify_one();
+            }
+        }
+    }
+
+    /// Execute the given task for `count` batch items using all workers.
+    auto execute(Index count, const std::function<void(Index, Index)>& fn) -> void
+    {
+        if(count == 0)
+            return;
+
+        // Start the background worker threads on first use
+        if(threads.empty())
+            for(Index k = 1; k < numthreads; ++k)
+                threads.emplace_back([=] { run(k); });
+
+        task = fn;
+
+        // Split the batch items in contiguous ranges among the workers
+        const auto chunk = (count + numthreads - 1)/numthreads;
+        for(Index k = 0; k < numthreads; ++k)
+        {
+            ranges[k].begin = std::min(k*chunk, count);
+            ranges[k].end = std::min((k + 1)*chunk, count);
+            errors[k] = nullptr;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending = numthreads - 1;
+            ++generation;
+        }
+        cvstart.notify_all();
+
+        process(0); // the calling thread also works on the batch
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cvdone.wait(lock, [&] { return pending == 0; });
+        }
+
+        for(const auto& err : errors)
+            if(err) std::rethrow_exception(err);
+    }
+
+    /// Solve the batch of optimization problems.
+    auto solve(const std::vector<Problem>& problems, std::vector<State>& states) -> std::vector<Result>
+    {
+        const Index count = problems.size();
+
+        errorif(Index(states.size()) != count, "Cannot solve the batch of optimization problems. "
+            "There are ", count, " problems but ", states.size(), " states.");
+
+        std::vector<Result> results(count);
+
+        execute(count, [&](Index worker, Index i) {
+            results[i] = solvers[worker].solve(problems[i], states[i]);
+        });
+
+        return results;
+    }
+
+    /// Solve the batch of optimization problems and compute the sensitivity derivatives at the end.
+    auto solve(const std::vector<Problem>& problems, std::vector<State>& states, std::vector<Sensitivity>& sensitivities) -> std::vector<Result>
+    {
+        const Index count = problems.size();
+
+        errorif(Index(states.size()) != count, "Cannot solve the batch of optimization problems. "
+            "There are ", count, " problems but ", states.size(), " states.");
+
+        sensitivities.resize(count);
+
+        std::vector<Result> results(count);
+
+        execute(count, [&](Index worker, Index i) {
+            results[i] = solvers[worker].solve(problems[i], states[i], sensitivities[i]);
+        });
+
+        return results;
+    }
+};
+
+BatchSolver::BatchSolver()
+: pimpl(new Impl(defaultNumThreads()))
+{}
+
+BatchSolver::BatchSolver(Index numthreads)
+: pimpl(new Impl(numthreads))
+{}
+
+BatchSolver::BatchSolver(const BatchSolver& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+BatchSolver::~BatchSolver()
+{}
+
+auto BatchSolver::operator=(BatchSolver other) -> BatchSolver&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto BatchSolver::setOptions(const Options& options) -> void
+{
+    pimpl->setOptions(options);
+}
+
+auto BatchSolver::numThreads() const -> Index
+{
+    return pimpl->numthreads;
+}
+
+auto BatchSolver::solve(const std::vector<Problem>& problems, std::vector<State>& states) -> std::vector<Result>
+{
+    return pimpl->solve(problems, states);
+}
+
+auto BatchSolver::solve(const std::vector<Problem>& problems, std::vector<State>& states, std::vector<Sensitivity>& sensitivities) -> std::vector<Result>
+{
+    return pimpl->solve(problems, states, sensitivities);
+}
+
+} // namespace Optima
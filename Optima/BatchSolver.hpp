@@ -0,0 +1,87 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+#include <vector>
+
+// Optima includes
+#include <Optima/Index.hpp>
+
+namespace Optima {
+
+// Forward declarations
+class Options;
+class Problem;
+class Result;
+class Sensitivity;
+class State;
+
+/// The solver for batches of independent optimization problems.
+/// The problems in a batch are solved concurrently by a pool of worker
+/// threads. Each worker owns its own Solver instance, so that the workspace
+/// of the solver is reused across all problems it processes, in this and in
+/// subsequent batch calculations. The problems are initially split among the
+/// workers in contiguous ranges, and idle workers steal half of the remaining
+/// range of a busy worker, so that problems requiring very different number of
+/// iterations are still evenly distributed among the threads.
+class BatchSolver
+{
+public:
+    /// Construct a default BatchSolver instance with one worker per hardware thread.
+    BatchSolver();
+
+    /// Construct a BatchSolver instance with given number of worker threads.
+    explicit BatchSolver(Index numthreads);
+
+    /// Construct a copy of a BatchSolver instance.
+    BatchSolver(const BatchSolver& other);
+
+    /// Destroy this BatchSolver instance.
+    virtual ~BatchSolver();
+
+    /// Assign a BatchSolver instance to this.
+    auto operator=(BatchSolver other) -> BatchSolver&;
+
+    /// Set the options for the optimization calculations.
+    auto setOptions(const Options& options) -> void;
+
+    /// Return the number of worker threads used in the batch calculations.
+    auto numThreads() const -> Index;
+
+    /// Solve the batch of optimization problems.
+    /// @param problems The optimization problems in the batch.
+    /// @param[in,out] states The initial guesses and final states of the optimization problems.
+    /// @return The result of each optimization calculation, in the same order as the problems.
+    auto solve(const std::vector<Problem>& problems, std::vector<State>& states) -> std::vector<Result>;
+
+    /// Solve the batch of optimization problems and compute the sensitivity derivatives at the end.
+    /// @param problems The optimization problems in the batch.
+    /// @param[in,out] states The initial guesses and final states of the optimization problems.
+    /// @param[out] sensitivities The sensitivity derivatives of the final states (resized to the number of problems if needed).
+    /// @return The result of each optimization calculation, in the same order as the problems.
+    auto solve(const std::vector<Problem>& problems, std::vector<State>& states, std::vector<Sensitivity>& sensitivities) -> std::vector<Result>;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
@@ -42,6 +42,7 @@ struct CanonicalMatrix
     IndicesView jn;     ///< The indices of the non-basic variables ordered as jn = (jns, jnu).
     IndicesView js;     ///< The indices of the stable variables ordered as js = (jbs, jns).
     IndicesView ju;     ///< The indices of the unstable variables ordered as ju = (jbu, jnu).
+    bool isHssDiag;     ///< The flag that indicates whether Hss is diagonal.
 };
 
 } // namespace Optima
@@ -70,4 +70,10 @@ using CanonicalVector     = CanonicalVectorBase<Vector>;
 using CanonicalVectorRef  = CanonicalVectorBase<VectorRef>;
 using CanonicalVectorView = CanonicalVectorBase<VectorView>;
 
+/// Used to represent canonical vectors stored column-wise (e.g., the right-hand sides in linear solves with multiple right-hand sides).
+using CanonicalVectorsRef  = CanonicalVectorBase<MatrixRef>;
+
+/// Used to represent immutable canonical vectors stored column-wise (e.g., the right-hand sides in linear solves with multiple right-hand sides).
+using CanonicalVectorsView = CanonicalVectorBase<MatrixView>;
+
 } // namespace Optima
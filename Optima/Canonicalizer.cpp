@@ -80,6 +80,9 @@ struct Canonicalizer::Impl
         const auto RWQ = M.RWQ;
         const auto ju0 = M.ju;
 
+        // The number of stable variables in the last update
+        const auto ns0 = ns;
+
         //======================================================================
         // Initialize number of basic/non-basic stable/unstable variables
         //======================================================================
@@ -99,11 +102,6 @@ struct Canonicalizer::Impl
         auto Sbn = S.topLeftCorner(nb, nn);
         auto Sbp = S.topRightCorner(nb, np);
 
-        R = RWQ.R;
-
-        Sbn = RWQ.Sbn;
-        Sbp = RWQ.Sbp;
-
         jbn.resize(nx);
         jbn << RWQ.jb, RWQ.jn; // the indices of the variables ordered as x = (xb, xn), but xb and xn not yet properly sorted
 
@@ -161,7 +159,7 @@ struct Canonicalizer::Impl
         {
             const auto idx = jn[k];                     // the global index of the k-th non-basic variable
             const auto Hkk = Hd[idx];                   // the corresponding diagonal entry in the H matrix
-            const auto a1 = norminf(Sbn.col(k));        // the max value along the corresponding column of the Sbn matrix
+            const auto a1 = norminf(RWQ.Sbn.col(k));    // the max value along the corresponding column of the Sbn matrix
             const auto a2 = norminf(V.Vpx.col(idx));    // the max value along the corresponding column of the Vpx matrix
             return abs(Hkk) >= std::max(a1, a2);        // return true if diagonal entry is dominant with respect to Vpx and Sbn only (not Hxx!)
         };
@@ -176,15 +174,21 @@ struct Canonicalizer::Impl
         //======================================================================
         // Apply permutation to R, Sbn, Sbp and indices of variables jbn
         //======================================================================
-        Kb.asPermutation().transpose().applyThisOnTheLeft(Sbn);
-        Kb.asPermutation().transpose().applyThisOnTheLeft(Sbp);
+        using Eigen::all;
+
+        // Note: the permuted matrices are gathered from RWQ instead of permuted
+        // in-place, because in-place permutations allocate memory. Views of Kb
+        // and Kn are used as indices, because indexing with Indices copies them.
+        const IndicesView kb = Kb;
+        const IndicesView kn = Kn;
 
-        Kn.asPermutation().applyThisOnTheRight(Sbn);
+        R = RWQ.R(kb, all);
 
-        Kb.asPermutation().transpose().applyThisOnTheLeft(R);
+        Sbn = RWQ.Sbn(kb, kn);
+        Sbp = RWQ.Sbp(kb, all);
 
-        Kb.asPermutation().transpose().applyThisOnTheLeft(jb); // jb is now ordered as (jbs, jbu) = (jbe, jbi, jbu)
-        Kn.asPermutation().transpose().applyThisOnTheLeft(jn); // jn is now ordered as (jns, jnu) = (jne, jni, jnu)
+        jb = RWQ.jb(kb); // jb is now ordered as (jbs, jbu) = (jbe, jbi, jbu)
+        jn = RWQ.jn(kn); // jn is now ordered as (jns, jnu) = (jne, jni, jnu)
 
         // ---------------------------------------------------------------------
         // ***NOTE***
@@ -214,6 +218,10 @@ struct Canonicalizer::Impl
         const auto jns = jn.head(nns);
         const auto jnu = jn.tail(nnu);
 
+        // Check if the ordering of the stable and unstable variables is the same as in the last update
+        const auto samejsu = ns == ns0 && jsu.size() == nx &&
+            jsu.head(nbs) == jbs && jsu.segment(nbs, nns) == jns && jsu.tail(nnu) == jnu;
+
         // Initialize jsu = (jbs, jns, jnu)
         jsu.resize(nx);
         jsu << jbs, jns, jnu;
@@ -225,13 +233,20 @@ struct Canonicalizer::Impl
         //=========================================================================================
         // Initialize matrices Hss, Hsp
         //=========================================================================================
-        using Eigen::all;
+
+        // Check if Hss has been gathered in the last update from a diagonal matrix Hxx with the same ordering of the stable variables
+        const auto samediagHss = samejsu && diagHxx && H.isHxxDiag && Hprime.rows() == nx && Hprime.cols() == nx + np;
 
         Hprime.resize(nx, nx + np);
         auto Hss = Hprime.topLeftCorner(ns, ns);
         auto Hsp = Hprime.topRightCorner(ns, np);
 
-        Hss = H.Hxx(js, js);
+        // Only the diagonal of Hss needs to be gathered if its off-diagonal entries are still zero
+        if(samediagHss)
+            for(Index i = 0; i < ns; ++i)
+                Hss(i, i) = H.Hxx(js[i], js[i]);
+        else Hss = H.Hxx(js, js);
+
         Hsp = H.Hxp(js, all);
 
         diagHxx = H.isHxxDiag;
@@ -277,7 +292,7 @@ struct Canonicalizer::Impl
         const auto js = jsu.head(ns);
         const auto ju = jsu.tail(nu);
 
-        return {dims, Hss, Hsp, Vps, Vpp, Sbsns, Sbsp, Rbs, jb, jn, js, ju};
+        return {dims, Hss, Hsp, Vps, Vpp, Sbsns, Sbsp, Rbs, jb, jn, js, ju, diagHxx};
     }
 };
 
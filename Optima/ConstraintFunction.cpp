@@ -19,6 +19,7 @@
 
 // Optima includes
 #include <Optima/Exception.hpp>
+#include <Optima/HeapAllocationGuard.hpp>
 
 namespace Optima {
 
@@ -54,6 +55,10 @@ auto ConstraintFunction::operator()(ConstraintResultRef res, VectorView x, Vecto
     res.ddc.fill(0.0);
     res.ddx4basicvars = false;
     res.succeeded = true;
+
+    // Heap allocations are allowed in the evaluation of the user function
+    const HeapAllocationGuard guard(true);
+
     fn(res, x, p, c, opts);
 }
 
@@ -17,6 +17,11 @@
 
 #include "Echelonizer.hpp"
 
+// C++ includes
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+
 // Eigen includes
 #include <Eigen/Dense>
 
@@ -35,8 +40,93 @@ auto identical(const MatrixView& A, const MatrixView& B)
 
 struct Echelonizer::Impl
 {
-    /// The full-pivoting LU decomposition of A so that P*A*Q = L*U;
-    Eigen::FullPivLU<Matrix> lu;
+    //======================================================================
+    // Note: The echelon form of A is computed with Gauss-Jordan elimination
+    // using threshold Markowitz pivoting. Among the entries in the remaining
+    // bottom-right corner that are not too small compared with the largest
+    // one in their column, the pivot is the one with the least Markowitz
+    // count (r - 1)*(c - 1), where r and c are the number of non-zero
+    // entries in its row and column. This reduces the fill-in of R and S for
+    // sparse matrices A, such as formula matrices with a few non-zero
+    // entries per column. Ties are broken by the magnitude of the entries,
+    // and so full pivoting is recovered for dense matrices. The elimination
+    // steps and the basis swap operations only update the columns with
+    // non-zero entries in the pivot row, each with a contiguous axpy
+    // operation on its column.
+    //======================================================================
+
+    //======================================================================
+    // Note: When the canonical form is computed with given basic variables,
+    // as for a matrix that changes slightly from one call to the next, the
+    // pivot search of the Gauss-Jordan elimination is skipped. Instead, the
+    // square matrix B with the columns of the basic variables is decomposed
+    // with partial pivoting, and R = inv(B) and S = R*N are computed with
+    // dense triangular solves and a matrix-matrix product. The reciprocal
+    // condition number of B in the 1-norm is then computed exactly from B
+    // and R, and the Gauss-Jordan elimination is used if it is too small.
+    //======================================================================
+
+    /// The reciprocal condition number of B below which the given basic variables are not accepted.
+    static constexpr double rcondmin = 1e-8;
+
+    //======================================================================
+    // Note: The round-off errors introduced in R and S by a basis swap are
+    // estimated as eps*g, where g is the product of the largest entries in
+    // the pivot column of S and in the normalized pivot row of R and S. The
+    // sum of these estimates since R and S were last computed from A is
+    // kept in `drift`. Once the accumulated errors may exceed the threshold
+    // used to identify the non-zero entries of S, R and S are computed again
+    // from A for the current basic variables. If this is not possible,
+    // because A has linearly dependent rows or the columns of the basic
+    // variables are ill-conditioned, the canonical form is reset to R0, S0
+    // and Q0, and the current basic variables are brought back into the
+    // basis with swaps whose pivots are the largest entries in their
+    // columns of S (a basic variable is left out if there is no acceptable
+    // pivot). Since R and S are not changed by the swaps in most calls to
+    // updateWithPriorityWeights, the cleanup of residual round-off errors is
+    // also skipped if no swap was performed since the last cleanup.
+    //======================================================================
+
+    //======================================================================
+    // Note: The entries of S computed after a few basis swaps may be only
+    // round-off errors left by the cancellation of much larger numbers, such
+    // as those that should be zero in a formula matrix with a few non-zero
+    // entries per column. These entries are not accepted as pivots in the
+    // swaps of updateWithPriorityWeights, since a swap with such a pivot
+    // would make the entries of R and S grow without bound and their columns
+    // of the basic variables singular. The pivots must thus be greater than
+    // the threshold used to compare the entries in S and also greater than
+    // a fraction `pivotmin` of the largest entry in their row of S.
+    //======================================================================
+
+    /// The fraction of the largest entry in a row of S below which its entries are not accepted as pivots in the swaps.
+    static constexpr double pivotmin = 1e-8;
+
+    //======================================================================
+    // Note: If the entries in A are small integers (e.g., the stoichiometric
+    // coefficients in a formula matrix), the echelon form is computed and
+    // updated exactly with rational arithmetic. In this case, the entries
+    // in each row of R and S are the integers in the same row of Rn and Sn
+    // divided by a common positive denominator in dn, and these fractions
+    // are reduced only when their integers become large. The matrices R
+    // and S are then the correctly rounded values of these rational
+    // numbers, without accumulated round-off errors, and the tests for zero
+    // entries when selecting pivots and basic variables are exact. If any
+    // integer remains too large after reduction, the exact arithmetic is
+    // abandoned and the floating-point operations are used instead.
+    //======================================================================
+
+    /// The integer type used in the exact echelon form.
+    using Int = std::int64_t;
+
+    /// The integer matrix type used in the exact echelon form, whose row operations are contiguous.
+    using IntMatrix = Eigen::Matrix<Int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    /// The integer vector type used in the exact echelon form.
+    using IntVector = Eigen::Matrix<Int, Eigen::Dynamic, 1>;
+
+    /// The largest absolute value of the integers in the exact echelon form, so that `a*b - c*d` does not overflow.
+    static constexpr Int intmax = (Int(1) << 31) - 1;
 
     /// The matrix A being echelonized.
     Matrix A;
@@ -50,10 +140,7 @@ struct Echelonizer::Impl
     /// The current matrix S in the canonical form C = [I S].
     Matrix S;
 
-    /// The permutation matrix P.
-    Indices P;
-
-    /// The transpose of the permutation matrix P.
+    /// The indices of the original equations associated with the canonical equations (the transpose of the row permutation matrix).
     Indices Ptr;
 
     /// The permutation matrix Q.
@@ -68,6 +155,51 @@ struct Echelonizer::Impl
     /// The matrix M used in the swap operation.
     Vector M;
 
+    /// The workspace for matrix A during its Gauss-Jordan elimination.
+    Matrix Aw;
+
+    /// The workspace for the number of non-zero entries in the rows and columns of the remaining bottom-right corner of Aw.
+    Indices nzrow, nzcol;
+
+    /// The workspace for the largest absolute entries in the columns of the remaining bottom-right corner of Aw.
+    Vector colmax;
+
+    /// The workspace for the indices of the columns with non-zero entries in the pivot row of R and S (or Aw).
+    Indices icolsR, icolsS;
+
+    /// The workspace for the row operations of the swaps in the rank-k update of R and S, with the unit entries of the leaving basic variables in U.
+    Matrix Uw, URw;
+
+    /// The workspace for the entries of the row operations of the swaps in the columns of the entering non-basic variables.
+    Matrix Lw;
+
+    /// The workspace for the coefficients of the row operations of the swaps in the rank-k update of R and S.
+    Matrix Cw;
+
+    /// The workspace for the coefficients of the row operations of the swaps in the row being searched.
+    Vector cw;
+
+    /// The workspace for the current row of S and R being normalized as a pivot row.
+    Vector Sr, Rr;
+
+    /// The workspace for the columns and rows of the swaps.
+    Indices ins, ibs;
+
+    /// The columns of S in descend order of the weights of their non-basic variables, with ties in ascend order of the columns.
+    Indices jorder;
+
+    /// The workspace for the positions of the variables in Q before the swaps are replayed.
+    Indices Qpos;
+
+    /// The workspace matrix used to rearrange the rows and columns of S without memory allocation.
+    Matrix Sw;
+
+    /// The workspace matrix used to rearrange the rows of R without memory allocation.
+    Matrix Rw;
+
+    /// The workspace permutation matrix used to rearrange Q without memory allocation.
+    Indices Qw;
+
     /// The permutation matrix Kb used in the weighted update method.
     PermutationMatrix Kb;
 
@@ -83,28 +215,375 @@ struct Echelonizer::Impl
     /// The backup permutation matrix Q used to reset this object to a state with non-accumulated round-off errors.
     Indices Q0;
 
+    /// The flag that indicates if the echelon form is currently exact.
+    bool exact = false;
+
+    /// The numerators of the entries in R in the exact echelon form.
+    IntMatrix Rn;
+
+    /// The numerators of the entries in S in the exact echelon form.
+    IntMatrix Sn;
+
+    /// The common denominators of the entries in each row of R and S in the exact echelon form.
+    IntVector dn;
+
+    /// The workspace for matrix A during its exact Gauss-Jordan elimination.
+    IntMatrix Awn;
+
+    /// The vector Mn used in the exact swap operation.
+    IntVector Mn;
+
+    /// The workspace matrices used to rearrange Sn and the rows of Rn without memory allocation.
+    IntMatrix Snw, Rnw;
+
+    /// The workspace vector used to rearrange dn without memory allocation.
+    IntVector dnw;
+
+    /// The backup of the flag that indicates if the echelon form is exact.
+    bool exact0 = false;
+
+    /// The backup matrix Rn used to reset this object.
+    IntMatrix Rn0;
+
+    /// The backup matrix Sn used to reset this object.
+    IntMatrix Sn0;
+
+    /// The backup denominators dn used to reset this object.
+    IntVector dn0;
+
+    /// The LU decomposition of the columns of the basic variables used when computing the canonical form with given basic variables.
+    Eigen::PartialPivLU<Matrix> luB;
+
+    /// The workspace for the columns of the basic variables and the identity matrix used when computing the canonical form with given basic variables.
+    Matrix Bw;
+
     /// The threshold used to compare numbers.
     double threshold;
 
+    /// The estimated round-off errors accumulated in R and S by the basis swaps since they were last computed from A, in multiples of the machine epsilon.
+    double drift = 0.0;
+
+    /// The flag that indicates if R and S have changed since their last cleanup of residual round-off errors.
+    bool dirty = true;
+
     /// The number used for eliminating round-off errors during cleanup procedure.
     /// This is computed as 10**[1 + ceil(log10(maxAij))], where maxAij is the
     /// inf norm of matrix A. For each entry in R and S, we add sigma and
     /// subtract sigma, so that residual round-off errors are eliminated.
     double sigma;
 
-    /// Return the number of basic variables, which is also the the rank of matrix A.
-    auto numBasicVariables() -> Index
+    /// Collect in `icols` the indices of the non-zero entries in given vector and return their number.
+    template<typename VectorType>
+    static auto nonzeros(const VectorType& vec, Indices& icols) -> Index
+    {
+        Index count = 0;
+        for(Index j = 0; j < vec.size(); ++j)
+            if(vec[j] != 0.0)
+                icols[count++] = j;
+        return count;
+    }
+
+    /// Return true if the entries in given matrix are integers not greater than @ref intmax in absolute value.
+    static auto isIntegral(MatrixView mat) -> bool
+    {
+        for(Index j = 0; j < mat.cols(); ++j)
+            for(Index i = 0; i < mat.rows(); ++i)
+                if(!(std::abs(mat(i, j)) <= intmax) || mat(i, j) != std::round(mat(i, j)))
+                    return false;
+        return true;
+    }
+
+    /// Reduce the fractions in row `i` of X and Y, whose common denominator is `den`, if any of their integers is too large.
+    /// The fractions are not reduced otherwise, because the rational numbers they represent are the same.
+    /// @return False if any of the integers is still too large.
+    static auto reduceRow(IntMatrix& X, IntMatrix& Y, Index i, Int& den) -> bool
     {
-        // Check if max pivot is very small
-        if(lu.maxPivot() < 10*std::numeric_limits<double>::epsilon())
+        const auto small = [&]
+        {
+            return den <= intmax
+                && (X.row(i).array().abs() <= intmax).all()
+                && (Y.row(i).array().abs() <= intmax).all();
+        };
+
+        if(small())
+            return true;
+
+        Int g = den;
+        for(Index j = 0; j < X.cols() && g != 1; ++j)
+            g = std::gcd(g, X(i, j));
+        for(Index j = 0; j < Y.cols() && g != 1; ++j)
+            g = std::gcd(g, Y(i, j));
+
+        if(g != 1)
         {
-            const auto previous_threshold = lu.threshold();
-            lu.setThreshold(1.0); // In this case, set threshold to 1, to effectively obtain an absolute comparion instead of relative
-            const auto r = lu.rank();
-            lu.setThreshold(previous_threshold);
-            return r;
+            X.row(i) /= g;
+            Y.row(i) /= g;
+            den /= g;
         }
-        else return lu.rank();
+
+        return small();
+    }
+
+    /// Divide row `k` of X and Y by the pivot `p/dn[k]`, which only changes their common denominator to `p`.
+    /// @return False if any of the resulting integers is too large.
+    static auto normalizeRow(IntMatrix& X, IntMatrix& Y, IntVector& dn, Index k, Int p) -> bool
+    {
+        dn[k] = p;
+        if(dn[k] < 0)
+        {
+            X.row(k) *= -1;
+            Y.row(k) *= -1;
+            dn[k] *= -1;
+        }
+        return reduceRow(X, Y, k, dn[k]);
+    }
+
+    /// Subtract `a` times the normalized row `k` of X and Y from their row `i`.
+    /// @return False if any of the resulting integers is too large.
+    static auto eliminateRow(IntMatrix& X, IntMatrix& Y, IntVector& dn, Index i, Index k, Int a) -> bool
+    {
+        X.row(i) = X.row(i) * dn[k] - a * X.row(k);
+        Y.row(i) = Y.row(i) * dn[k] - a * Y.row(k);
+        dn[i] *= dn[k];
+        return reduceRow(X, Y, i, dn[i]);
+    }
+
+    /// Set row `i` of R and S (if `i` is below the number of rows of S) from the exact echelon form.
+    auto convertRow(Index i) -> void
+    {
+        R.row(i) = Rn.row(i).cast<double>() / double(dn[i]);
+        if(i < S.rows())
+            S.row(i) = Sn.row(i).cast<double>() / double(dn[i]);
+    }
+
+    /// Perform the Gauss-Jordan elimination of A so that R*A*Q = [I S; 0 0].
+    auto eliminate() -> void
+    {
+        // The number of rows and columns of A
+        const auto m = A.rows();
+        const auto n = A.cols();
+
+        // The threshold for the pivots relative to the largest entry in their column
+        const auto u = 0.1;
+
+        // The largest absolute entry in A and the tolerance below which entries are considered zero
+        const auto eps = std::numeric_limits<double>::epsilon();
+        const auto maxA = A.size() ? A.cwiseAbs().maxCoeff() : 0.0;
+        const auto tol = maxA < 10*eps ? maxA : eps * std::min(m, n) * maxA; // if A is practically zero, no pivot is accepted
+
+        Aw = A;
+        R = identity(m, m);
+        Q = indices(n);
+        Ptr = indices(m);
+
+        nzrow.resize(m);
+        nzcol.resize(n);
+        colmax.resize(n);
+        icolsR.resize(m);
+        icolsS.resize(n);
+        M.resize(m);
+
+        rankA = 0;
+
+        for(Index k = 0; k < std::min(m, n); ++k)
+        {
+            const auto Ak = Aw.bottomRightCorner(m - k, n - k);
+
+            // Count the non-zero entries in the rows and columns of the remaining bottom-right corner
+            nzrow.head(m - k).fill(0);
+            for(Index j = 0; j < n - k; ++j)
+            {
+                nzcol[j] = 0;
+                colmax[j] = 0.0;
+                for(Index i = 0; i < m - k; ++i)
+                {
+                    const auto a = std::abs(Ak(i, j));
+                    const auto nonzero = a > tol;
+                    nzrow[i] += nonzero;
+                    nzcol[j] += nonzero;
+                    colmax[j] = std::max(colmax[j], a);
+                }
+            }
+
+            // Find the pivot with least Markowitz count among the entries not too small compared with the largest in their column
+            Index ipivot = -1, jpivot = -1;
+            double mincount = infinity(), maxabs = 0.0;
+            for(Index j = 0; j < n - k; ++j)
+            {
+                if(nzcol[j] == 0) continue;
+                for(Index i = 0; i < m - k; ++i)
+                {
+                    const auto a = std::abs(Ak(i, j));
+                    if(a <= tol || a < u * colmax[j]) continue;
+                    const double count = (nzrow[i] - 1) * (nzcol[j] - 1);
+                    if(count < mincount || (count == mincount && a > maxabs))
+                    {
+                        mincount = count;
+                        maxabs = a;
+                        ipivot = i;
+                        jpivot = j;
+                    }
+                }
+            }
+
+            // Stop if the remaining corner is zero
+            if(ipivot == -1)
+                break;
+
+            ipivot += k;
+            jpivot += k;
+
+            // Bring the pivot to position (k, k)
+            if(ipivot != k)
+            {
+                Aw.row(k).swap(Aw.row(ipivot));
+                R.row(k).swap(R.row(ipivot));
+                std::swap(Ptr[k], Ptr[ipivot]);
+            }
+            if(jpivot != k)
+            {
+                Aw.col(k).swap(Aw.col(jpivot));
+                std::swap(Q[k], Q[jpivot]);
+            }
+
+            // Normalize the pivot row (its entries before column k are zero)
+            const auto aux = 1.0/Aw(k, k);
+            Aw.row(k).tail(n - k) *= aux;
+            R.row(k) *= aux;
+
+            // Eliminate the entries in column k of the other rows using only the non-zero entries in the pivot row
+            M = Aw.col(k);
+            M[k] = 0.0; // the pivot row is not updated
+
+            const auto ncolsA = nonzeros(Aw.row(k), icolsS);
+            const auto ncolsR = nonzeros(R.row(k), icolsR);
+
+            for(Index c = 0; c < ncolsA; ++c)
+                Aw.col(icolsS[c]) -= Aw(k, icolsS[c]) * M;
+            for(Index c = 0; c < ncolsR; ++c)
+                R.col(icolsR[c]) -= R(k, icolsR[c]) * M;
+
+            ++rankA;
+        }
+
+        // Set the threshold used to compare the entries in S
+        threshold = maxA * eps * std::min(m, n) * std::max(m, n);
+    }
+
+    /// Perform the exact Gauss-Jordan elimination of A, whose entries must be integers.
+    /// @return False if the elimination failed because the integers became too large.
+    auto eliminateExact() -> bool
+    {
+        // The number of rows and columns of A
+        const auto m = A.rows();
+        const auto n = A.cols();
+
+        // The threshold for the pivots relative to the largest entry in their column
+        const auto u = 0.1;
+
+        // The largest absolute entry in A used to compare the entries in S
+        const auto eps = std::numeric_limits<double>::epsilon();
+        const auto maxA = A.size() ? A.cwiseAbs().maxCoeff() : 0.0;
+
+        Awn = A.cast<Int>();
+        Rn = IntMatrix::Identity(m, m);
+        dn = IntVector::Ones(m);
+        Q = indices(n);
+        Ptr = indices(m);
+
+        nzrow.resize(m);
+        nzcol.resize(n);
+        colmax.resize(n);
+        icolsR.resize(m); // used in the floating-point swaps if the exact arithmetic is abandoned
+        icolsS.resize(n);
+
+        rankA = 0;
+
+        for(Index k = 0; k < std::min(m, n); ++k)
+        {
+            const auto Ak = Awn.bottomRightCorner(m - k, n - k);
+
+            // Count the non-zero entries in the rows and columns of the remaining bottom-right corner
+            nzrow.head(m - k).fill(0);
+            for(Index j = 0; j < n - k; ++j)
+            {
+                nzcol[j] = 0;
+                colmax[j] = 0.0;
+                for(Index i = 0; i < m - k; ++i)
+                {
+                    const auto nonzero = Ak(i, j) != 0;
+                    nzrow[i] += nonzero;
+                    nzcol[j] += nonzero;
+                    colmax[j] = std::max(colmax[j], std::abs(double(Ak(i, j))/dn[k + i]));
+                }
+            }
+
+            // Find the pivot with least Markowitz count among the entries not too small compared with the largest in their column
+            Index ipivot = -1, jpivot = -1;
+            double mincount = infinity(), maxabs = 0.0;
+            for(Index j = 0; j < n - k; ++j)
+            {
+                if(nzcol[j] == 0) continue;
+                for(Index i = 0; i < m - k; ++i)
+                {
+                    if(Ak(i, j) == 0) continue;
+                    const auto a = std::abs(double(Ak(i, j))/dn[k + i]);
+                    if(a < u * colmax[j]) continue;
+                    const double count = (nzrow[i] - 1) * (nzcol[j] - 1);
+                    if(count < mincount || (count == mincount && a > maxabs))
+                    {
+                        mincount = count;
+                        maxabs = a;
+                        ipivot = i;
+                        jpivot = j;
+                    }
+                }
+            }
+
+            // Stop if the remaining corner is zero
+            if(ipivot == -1)
+                break;
+
+            ipivot += k;
+            jpivot += k;
+
+            // Bring the pivot to position (k, k)
+            if(ipivot != k)
+            {
+                Awn.row(k).swap(Awn.row(ipivot));
+                Rn.row(k).swap(Rn.row(ipivot));
+                std::swap(dn[k], dn[ipivot]);
+                std::swap(Ptr[k], Ptr[ipivot]);
+            }
+            if(jpivot != k)
+            {
+                Awn.col(k).swap(Awn.col(jpivot));
+                std::swap(Q[k], Q[jpivot]);
+            }
+
+            // Normalize the pivot row and eliminate the entries in column k of the other rows
+            if(!normalizeRow(Awn, Rn, dn, k, Awn(k, k)))
+                return false;
+
+            for(Index i = 0; i < m; ++i)
+                if(i != k && Awn(i, k) != 0)
+                    if(!eliminateRow(Awn, Rn, dn, i, k, Awn(i, k)))
+                        return false;
+
+            ++rankA;
+        }
+
+        // Set the floating-point matrices R and S from the exact ones
+        Sn = Awn.topRightCorner(rankA, n - rankA);
+        R.resize(m, m);
+        S.resize(rankA, n - rankA);
+        for(Index i = 0; i < m; ++i)
+            convertRow(i);
+
+        // Set the threshold used to compare the entries in S
+        threshold = maxA * eps * std::min(m, n) * std::max(m, n);
+
+        return true;
     }
 
     /// Compute the canonical matrix of the given matrix.
@@ -116,67 +595,187 @@ struct Echelonizer::Impl
 
         A = Anew;
 
-        // The number of rows and columns of A
-        const auto m = A.rows();
+        // The number of columns of A
         const auto n = A.cols();
 
         /// Initialize the current ordering of the variables
         inv_ordering = indices(n);
 
-        // Compute the full-pivoting LU of A so that P*A*Q = L*U
-        lu.compute(A);
-
-        // Update the rank of matrix A
-        rankA = numBasicVariables();
+        // Compute the echelon form R*A*Q = [I S; 0 0] with exact or floating-point Gauss-Jordan elimination
+        exact = isIntegral(A) && eliminateExact();
+        if(!exact)
+            eliminate();
 
         // The number of basic and non-basic columns of A.
         const auto nb = rankA;
         const auto nn = n - rankA;
 
-        // Get the LU factors of matrix A
-        const auto Lbb = lu.matrixLU().topLeftCorner(nb, nb).triangularView<Eigen::UnitLower>();
-        const auto U   = lu.matrixLU().rightCols(n).triangularView<Eigen::Upper>();
-        const auto Ubb = lu.matrixLU().topLeftCorner(nb, nb).triangularView<Eigen::Upper>();
-        const auto Ubn = lu.matrixLU().topRightCorner(nb, nn);
+        // Set matrix S
+        if(!exact)
+            S = Aw.topRightCorner(nb, nn);
 
-        // Set the permutation matrices P and Q
-        P = lu.permutationP().indices().cast<Index>();
-        Q = lu.permutationQ().indices().cast<Index>();
+        // Initialize the workspace and the backup of the canonical form
+        initializeWorkspace();
+    }
 
-        // Initialize the permutation matrix Q(aux)
-        Qaux = Q;
+    /// Compute the canonical matrix of the given matrix with given basic variables.
+    auto computeWithBasicVariables(MatrixView Anew, IndicesView ibasic) -> void
+    {
+        // Avoid echelonization if Anew is A
+        if(identical(Anew, A))
+            return;
+
+        // The number of rows and columns of A, and of basic variables
+        const auto m = Anew.rows();
+        const auto n = Anew.cols();
+        const auto nb = ibasic.size();
 
-        Ptr.resize(m);
-        Ptr(P) = indices(m);
+        // Use the Gauss-Jordan elimination if the basic variables do not form a square matrix B, if
+        // the dimensions of A have changed (to avoid resizing the workspace), or if A can be echelonized exactly
+        if(m == 0 || nb != m || nb > n || A.rows() != m || A.cols() != n || isIntegral(Anew))
+            return compute(Anew);
 
-        // Calculate the regularizer matrix R
-        R = P.asPermutation();
-        R.topRows(nb) = Lbb.solve(R.topRows(nb)); // [L] = 6x5, [R] = 6x6, [Lbb] = 5x5
-        R.topRows(nb) = Ubb.solve(R.topRows(nb));
+        // Mark the basic variables in Qw, also checking that they are distinct
+        Qw.fill(0);
+        for(Index k = 0; k < nb; ++k)
+        {
+            const auto j = ibasic[k];
+            if(j < 0 || j >= n || Qw[j])
+                return compute(Anew);
+            Qw[j] = 1;
+        }
+
+        // Set Q with the basic variables followed by the non-basic variables in ascend order
+        Q.head(nb) = ibasic;
+        for(Index j = 0, k = nb; j < n; ++j)
+            if(!Qw[j])
+                Q[k++] = j;
+
+        // Compute R and S with these basic variables, or use the Gauss-Jordan elimination if B is ill-conditioned
+        if(!computeWithBasis(Anew))
+            return compute(Anew);
+
+        A = Anew;
+        rankA = nb;
+        exact = false;
 
-        // Calculate matrix S
-        S = Ubn;
-        S = Ubb.solve(S);
+        // All equations are associated with a basic variable
+        std::iota(Ptr.begin(), Ptr.end(), 0);
+
+        // Set the threshold used to compare the entries in S
+        const auto eps = std::numeric_limits<double>::epsilon();
+        const auto maxA = A.cwiseAbs().maxCoeff();
+        threshold = maxA * eps * m * n;
+
+        // Initialize the workspace and the backup of the canonical form
+        initializeWorkspace();
+    }
+
+    /// Compute R = inv(B) and S = R*N for given matrix, where B and N have the columns of the basic and non-basic variables in Q.
+    /// The number of basic variables must be the number of rows of the matrix, and the workspace must have been initialized.
+    /// @return False if B is ill-conditioned, in which case R and S are not changed.
+    auto computeWithBasis(MatrixView Amat) -> bool
+    {
+        const auto m = Amat.rows();
+        const auto n = Amat.cols();
+        const auto nb = m;
+        const auto nn = n - nb;
+
+        // Decompose B and compute inv(B) in Rw
+        for(Index k = 0; k < nb; ++k)
+            Bw.col(k) = Amat.col(Q[k]);
+
+        const auto Bnorm = Bw.cwiseAbs().colwise().sum().maxCoeff();
+
+        luB.compute(Bw);
+        Bw.setIdentity();
+        Rw.noalias() = luB.solve(Bw);
+
+        const auto rcond = 1.0 / (Bnorm * Rw.cwiseAbs().colwise().sum().maxCoeff());
+        if(!std::isfinite(rcond) || rcond < rcondmin)
+            return false;
+
+        R.swap(Rw);
+
+        // Compute S = R*N, where N has the columns of the non-basic variables
+        Sw.resize(nb, nn);
+        for(Index k = 0; k < nn; ++k)
+            Sw.col(k) = Amat.col(Q[nb + k]);
+        S.noalias() = R * Sw;
+
+        return true;
+    }
+
+    /// Initialize the workspace and the backup of the canonical form just computed for A.
+    auto initializeWorkspace() -> void
+    {
+        // The number of rows and columns of A, and of basic and non-basic variables
+        const auto m = A.rows();
+        const auto n = A.cols();
+        const auto nb = rankA;
+        const auto nn = n - rankA;
+        // Initialize the permutation matrix Q(aux)
+        Qaux = Q;
 
         // Initialize the permutation matrices Kb and Kn
         Kb.setIdentity(nb);
         Kn.setIdentity(nn);
 
-        // Initialize the threshold value
-        threshold = std::abs(lu.maxPivot()) * lu.threshold() * std::max(A.rows(), A.cols());
+        // Initialize the workspace used in the swap and rearrangement operations
+        M.resize(nb);
+        Sw.resize(nb, nn);
+        Rw.resize(m, m);
+        Qw.resize(n);
+        Uw.resize(nb, nn);
+        URw.resize(nb, m);
+        Lw.resize(nb, nb);
+        Cw.resize(nb, nb);
+        cw.resize(nb);
+        Sr.resize(nn);
+        Rr.resize(m);
+        ins.resize(nb);
+        jorder.resize(nn);
+        Qpos.resize(n);
+        ibs.resize(nb);
+        Mn.resize(nb);
+        Snw.resize(nb, nn);
+        Rnw.resize(m, m);
+        dnw.resize(m);
+        Bw.resize(m, m);
+
+        // Initialize the LU decomposition of B without reallocating it for the same number of rows
+        if(luB.rows() != m)
+            luB = Eigen::PartialPivLU<Matrix>(m);
 
         // Compute sigma for given matrix A
         sigma = A.size() ? A.cwiseAbs().maxCoeff() : 0.0;
         sigma = A.size() ? std::pow(10, 1 + std::ceil(std::log10(sigma))) : 0.0;
 
+        // The canonical form has just been computed from A and not yet cleaned
+        drift = 0.0;
+        dirty = true;
+
         // Set the backup matrices R0, S0, Q0 for resetting purposes
         R0 = R;
         S0 = S;
         Q0 = Q;
+        exact0 = exact;
+        Rn0 = Rn;
+        Sn0 = Sn;
+        dn0 = dn;
     }
 
     /// Swap a basic variable by a non-basic variable.
     auto updateWithSwapBasicVariable(Index ib, Index in) -> void
+    {
+        swapBasicVariable(ib, in);
+
+        // Compute R and S again from A if the accumulated round-off errors are too large
+        controlRoundoffErrors();
+    }
+
+    /// Swap a basic variable by a non-basic variable without controlling the accumulated round-off errors.
+    auto swapBasicVariable(Index ib, Index in) -> void
     {
         // The number of basic and non-basic columns of A.
         const auto nb = rankA;
@@ -192,6 +791,10 @@ struct Echelonizer::Impl
             "Could not swap basic and non-basic variables. "
                 "Expecting an index of non-basic variable below `n - r`, where `r = rank(A)`.");
 
+        // Perform the swap with exact arithmetic, or leave exact mode if the integers become too large
+        if(exact && (exact = updateWithSwapBasicVariableExact(ib, in)))
+            return;
+
         // Check if S(ib, in) is different than zero
         assert(std::abs(S(ib, in)) > threshold &&
             "Could not swap basic and non-basic variables. "
@@ -204,89 +807,448 @@ struct Echelonizer::Impl
         const auto m = S.rows();
         const auto aux = 1.0/S(ib, in);
 
-        // Update the echelonizer matrix R (only its `r` upper rows, where `r = rank(A)`)
+        // Normalize the pivot rows of R and S
         R.row(ib) *= aux;
-        for(auto i = 0; i < m; ++i)
-            if(i != ib) R.row(i) -= S(i, in) * R.row(ib);
-
-        // Update matrix S
         S.row(ib) *= aux;
-        for(auto i = 0; i < m; ++i)
-            if(i != ib) S.row(i) -= S(i, in) * S.row(ib);
+
+        // Accumulate the estimated round-off errors introduced by this swap
+        drift += M.cwiseAbs().maxCoeff() * std::max(R.row(ib).cwiseAbs().maxCoeff(), S.row(ib).cwiseAbs().maxCoeff());
+
+        // Collect the non-zero entries in the pivot rows
+        const auto ncolsR = nonzeros(R.row(ib), icolsR);
+        const auto ncolsS = nonzeros(S.row(ib), icolsS);
+
+        // Update the echelonizer matrix R (only its `r` upper rows, where `r = rank(A)`) and matrix S
+        const auto Mib = M[ib];
+        M[ib] = 0.0; // the pivot row is not updated
+        for(Index c = 0; c < ncolsR; ++c)
+            R.col(icolsR[c]).head(m) -= R(ib, icolsR[c]) * M;
+        for(Index c = 0; c < ncolsS; ++c)
+            S.col(icolsS[c]) -= S(ib, icolsS[c]) * M;
+        M[ib] = Mib;
+
         S.col(in) = -M*aux;
         S(ib, in) = aux;
 
         // Update the permutation matrix Q
         std::swap(Q[ib], Q[m + in]);
+
+        dirty = true;
+    }
+
+    /// Swap a basic variable by a non-basic variable with exact arithmetic.
+    /// @return False if the swap failed because the integers became too large, in which case only Rn, Sn and dn were changed.
+    auto updateWithSwapBasicVariableExact(Index ib, Index in) -> bool
+    {
+        // The number of basic variables
+        const auto nb = rankA;
+
+        assert(Sn(ib, in) != 0 &&
+            "Could not swap basic and non-basic variables. "
+                "Expecting a non-basic variable with non-zero pivot.");
+
+        // Initialize the vector Mn
+        Mn = Sn.col(in);
+
+        // Normalize the pivot row, in which the entry in column `in`
+        // becomes the one of the leaving basic variable, 1/S(ib, in)
+        Sn(ib, in) = dn[ib];
+        if(!normalizeRow(Sn, Rn, dn, ib, Mn[ib]))
+            return false;
+
+        // Update the other rows of Sn and Rn (only its `nb` upper rows) with non-zero entries in column `in`
+        for(Index i = 0; i < nb; ++i)
+        {
+            if(i == ib || Mn[i] == 0) continue;
+            Sn(i, in) = 0;
+            if(!eliminateRow(Sn, Rn, dn, i, ib, Mn[i]))
+                return false;
+        }
+
+        // Set the rows of the floating-point matrices R and S that have changed
+        for(Index i = 0; i < nb; ++i)
+            if(Mn[i] != 0)
+                convertRow(i);
+
+        // Update the permutation matrix Q
+        std::swap(Q[ib], Q[nb + in]);
+
+        return true;
+    }
+
+    /// Sort the given indices in descend order of their weights, with ties in ascend order of the indices.
+    /// Insertion sort is used if the indices are nearly sorted already, as in consecutive calls to
+    /// @ref updateWithPriorityWeights with slightly changed weights, and `std::sort` otherwise.
+    template<typename IndexType, typename WeightFunction>
+    static auto sortByWeights(IndexType* idx, Index size, const WeightFunction& weight) -> void
+    {
+        auto precedes = [&](Index a, Index b)
+        {
+            const auto wa = weight(a);
+            const auto wb = weight(b);
+            return wa > wb || (wa == wb && a < b);
+        };
+
+        Index descents = 0;
+        for(Index t = 1; t < size; ++t)
+            descents += precedes(idx[t], idx[t - 1]);
+
+        if(descents > 8)
+            return std::sort(idx, idx + size, precedes);
+
+        for(Index t = 1; t < size; ++t)
+        {
+            const auto a = idx[t];
+            Index s = t;
+            for(; s > 0 && precedes(a, idx[s - 1]); --s)
+                idx[s] = idx[s - 1];
+            idx[s] = a;
+        }
+    }
+
+    /// Return the tolerance above which the entries in the given row of S are accepted as pivots in the swaps.
+    template<typename RowType>
+    auto pivotTolerance(const RowType& row) const -> double
+    {
+        return std::max(threshold, pivotmin * row.cwiseAbs().maxCoeff());
+    }
+
+    /// Find the non-basic variable with maximum weight, greater than that of the basic variable in row `i`, among those with non-zero entry in row `i` of S.
+    /// The columns of S are searched in the order in @ref jorder, so that the search stops at the first
+    /// column with non-zero entry or with weight not greater than that of the basic variable.
+    /// @param w The priority weights of the variables.
+    /// @param i The row of S.
+    /// @param entry The function that returns the entry in given column of the current row `i` of S.
+    /// @param[out] t The position in @ref jorder of the found column.
+    /// @return The found column of S, or -1 if there is none.
+    template<typename EntryFunction>
+    auto findNonBasicCandidate(VectorView w, Index i, const EntryFunction& entry, Index& t) const -> Index
+    {
+        const auto nb = rankA;
+        const auto nn = A.cols() - rankA;
+        const auto wi = w[Q[i]];
+        for(t = 0; t < nn && w[Q[nb + jorder[t]]] > wi; ++t)
+            if(entry(jorder[t]))
+                return jorder[t];
+        return -1;
+    }
+
+    /// Move column `j` of S at position `t` in @ref jorder after its variable has been swapped with a basic variable with lower weight.
+    auto updateColumnOrder(VectorView w, Index t, Index j) -> void
+    {
+        const auto nb = rankA;
+        const auto nn = A.cols() - rankA;
+        const auto wj = w[Q[nb + j]];
+        for(; t + 1 < nn; ++t)
+        {
+            const auto wt = w[Q[nb + jorder[t + 1]]];
+            if(wt < wj || (wt == wj && jorder[t + 1] > j))
+                break;
+            jorder[t] = jorder[t + 1];
+        }
+        jorder[t] = j;
+    }
+
+    /// Swap the basic variables by the non-basic variables with higher priority weights with a single rank-k update of R and S.
+    /// The swaps are chosen as if they were performed in sequence with @ref updateWithSwapBasicVariable,
+    /// but the rows of S are only computed as needed to find the swaps, and all rows of R and S are
+    /// updated at the end with matrix-matrix products. Since the entries of S are computed with a
+    /// different sequence of floating-point operations, a pivot close to the tolerance used to
+    /// accept it may be accepted in one case and not in the other.
+    auto updateWithSwapsBlocked(VectorView w) -> void
+    {
+        // The number of basic columns of A.
+        const auto nb = rankA;
+
+        // The number of swaps found so far
+        Index k = 0;
+
+        for(Index i = 0; i < nb; ++i)
+        {
+            // Compute the coefficients of the previous swaps in the row operations on row i
+            for(Index l = 0; l < k; ++l)
+                cw[l] = S(i, ins[l]) - cw.head(l).dot(Lw.col(l).head(l));
+
+            // Find a non-basic variable to be swapped, computing only the entries of the current row i of S that are needed
+            Index t;
+            auto j = findNonBasicCandidate(w, i, [&](Index c) {
+                return std::abs(S(i, c) - cw.head(k).dot(Uw.col(c).head(k))) > threshold; }, t);
+
+            if(j == -1)
+                continue;
+
+            // Compute the current row i of R and S
+            Sr = S.row(i);
+            Sr.noalias() -= Uw.topRows(k).transpose() * cw.head(k);
+            Rr = R.row(i);
+            Rr.noalias() -= URw.topRows(k).transpose() * cw.head(k);
+
+            // Find the non-basic variable to be swapped again, among those whose entries are not negligible in the current row
+            const auto tol = pivotTolerance(Sr);
+            j = findNonBasicCandidate(w, i, [&](Index c) { return std::abs(Sr[c]) > tol; }, t);
+
+            if(j == -1)
+                continue;
+
+            // Normalize the current row i of R and S by the pivot, in which the entry
+            // in column j becomes the one of the leaving basic variable, 1/S(i, j)
+            const auto aux = 1.0/Sr[j];
+            Sr[j] = 1.0;
+            Sr *= aux;
+            Rr *= aux;
+
+            // Store the row operation of this swap, in which the unit entry in column j accounts for its replacement by the leaving basic variable
+            Uw.row(k) = Sr;
+            Uw(k, j) += 1.0;
+            URw.row(k) = Rr;
+            for(Index l = 0; l < k; ++l)
+                Lw(l, k) = Uw(l, j);
+            ins[k] = j;
+            ibs[k] = i;
+            ++k;
+
+            // Update the permutation matrix Q and the order of the columns of S
+            std::swap(Q[i], Q[nb + j]);
+            updateColumnOrder(w, t, j);
+        }
+
+        if(k == 0)
+            return;
+
+        // Compute the coefficients of all row operations on each row of R and S,
+        // starting from the normalized pivot rows for the rows of the swaps
+        auto C = Cw.leftCols(k);
+        for(Index i = 0; i < nb; ++i)
+            for(Index l = 0; l < k; ++l)
+                C(i, l) = S(i, ins[l]);
+        for(Index l = 0; l < k; ++l)
+        {
+            C.row(ibs[l]).head(l + 1).fill(0.0);
+            for(Index r = l + 1; r < k; ++r)
+                C(ibs[l], r) = Uw(l, ins[r]) - (ins[r] == ins[l]);
+            S.row(ibs[l]) = Uw.row(l);
+            S(ibs[l], ins[l]) -= 1.0;
+            R.row(ibs[l]) = URw.row(l);
+        }
+        Lw.topLeftCorner(k, k).triangularView<Eigen::UnitUpper>().solveInPlace<Eigen::OnTheRight>(C);
+
+        // Accumulate the estimated round-off errors introduced by the swaps
+        for(Index l = 0; l < k; ++l)
+            drift += C.col(l).cwiseAbs().maxCoeff() * std::max(Uw.row(l).cwiseAbs().maxCoeff(), URw.row(l).cwiseAbs().maxCoeff());
+
+        // Update R (only its `nb` upper rows) and S with the rank-k update
+        S.noalias() -= C * Uw.topRows(k);
+        R.topRows(nb).noalias() -= C * URw.topRows(k);
+
+        dirty = true;
+
+        // Compute R and S again from A if the accumulated round-off errors are too large
+        controlRoundoffErrors();
+    }
+
+    /// Compute R and S again from A for the current basic and non-basic variables if their accumulated round-off errors are too large.
+    /// If A has linearly dependent rows or the columns of the basic variables are ill-conditioned, the swaps are replayed instead (see @ref replaySwaps).
+    auto controlRoundoffErrors() -> void
+    {
+        const auto eps = std::numeric_limits<double>::epsilon();
+
+        if(exact || eps * drift <= threshold)
+            return;
+
+        if(rankA == A.rows() && computeWithBasis(A))
+            drift = 0.0;
+        else replaySwaps();
+    }
+
+    /// Reset to the canonical form computed initially and bring the current basic variables back into the basis with basis swaps.
+    /// Each current basic variable that is not in the initial basis replaces the basic variable (not among the current ones) with
+    /// the largest entry in its column of S, if this entry is accepted as pivot. The current order of the variables is then restored.
+    auto replaySwaps() -> void
+    {
+        // The number of variables, and of basic and non-basic variables
+        const auto n = A.cols();
+        const auto nb = rankA;
+        const auto nn = n - rankA;
+
+        // Store the current positions of the variables in Q
+        for(Index k = 0; k < n; ++k)
+            Qpos[Q[k]] = k;
+
+        reset();
+
+        for(Index k = 0; k < nb; ++k)
+        {
+            // Find the column of S of the current basic variable in position k, unless it is already basic
+            Index in = 0;
+            while(in < nn && Qpos[Q[nb + in]] != k)
+                ++in;
+
+            if(in == nn)
+                continue;
+
+            // Find the row of S with the largest entry in this column among those of the basic variables to be replaced
+            Index ib = -1;
+            double maxabs = 0.0;
+            for(Index i = 0; i < nb; ++i)
+            {
+                if(Qpos[Q[i]] < nb) continue;
+                const auto a = exact ? std::abs(double(Sn(i, in))/dn[i]) : std::abs(S(i, in));
+                if(a > maxabs && (exact || a > pivotTolerance(S.row(i))))
+                {
+                    maxabs = a;
+                    ib = i;
+                }
+            }
+
+            if(ib != -1)
+                swapBasicVariable(ib, in);
+        }
+
+        // Restore the current order of the variables. A basic variable left out of the basis takes the position
+        // in Q of the non-basic variable that replaced it, as if the swap of these two variables had been rejected.
+        Kb.setIdentity(nb);
+        Kn.setIdentity(nn);
+
+        for(Index i = 0, j = 0; i < nb; ++i)
+        {
+            if(Qpos[Q[i]] >= nb)
+            {
+                while(Qpos[Q[nb + j]] >= nb)
+                    ++j;
+                std::swap(Qpos[Q[i]], Qpos[Q[nb + j]]);
+            }
+            Kb.indices()[Qpos[Q[i]]] = i;
+        }
+
+        for(Index j = 0; j < nn; ++j)
+            Kn.indices()[Qpos[Q[nb + j]] - nb] = j;
+
+        rearrange(Kb, Kn);
+
+        Kb.setIdentity(nb);
+        Kn.setIdentity(nn);
     }
 
     /// Update the existing canonical form with given priority weights for the columns.
     auto updateWithPriorityWeights(VectorView w) -> void
     {
         // Assert there are as many weights as there are variables
-        assert(w.rows() == lu.cols() &&
+        assert(w.rows() == A.cols() &&
             "Could not update the canonical form."
                 "Mismatch number of variables and given priority weights.");
 
+        //======================================================================
+        // Note: This method is called in every iteration of the optimization
+        // calculation with slightly changed weights, so that the basic and
+        // non-basic variables are usually already sorted in descend order of
+        // weights, and there are rarely variables to be swapped. The columns
+        // of S are thus sorted with insertion sort starting from their current
+        // order, and the search for a non-basic variable to be swapped with a
+        // basic variable only checks the columns with greater weights, in
+        // descend order, until one with non-zero entry is found. Only the rows
+        // and columns of R, S and Q whose positions change are then moved.
+        //======================================================================
+
         // The number of basic and non-basic columns of A.
         const auto nb = rankA;
         const auto nn = A.cols() - rankA;
 
-        // The upper part of R corresponding to linearly independent rows of A
-        auto Rb = R.topRows(nb);
-
         // The indices of the basic and non-basic variables
         auto ibasic = Q.head(nb);
         auto inonbasic = Q.tail(nn);
 
-        // Find the non-basic variable with maximum proportional weight with respect to a basic variable
-        auto find_nonbasic_candidate = [&](Index i, Index& j)
-        {
-            j = 0; double max = -infinity();
-            double tmp = 0.0;
-            for(Index k = 0; k < nn; ++k) {
-                if(std::abs(S(i, k)) <= threshold) continue;
-                tmp = w[inonbasic[k]];
-                if(tmp > max) {
-                    max = tmp;
-                    j = k;
-                }
-            }
-            return max;
-        };
+        // Sort the columns of S in descend order of the weights of their non-basic variables
+        for(Index j = 0; j < nn; ++j)
+            jorder[j] = j;
+        sortByWeights(jorder.data(), nn, [&](Index j) { return w[inonbasic[j]]; });
 
         // Check if there are basic variables to be swapped with non-basic variables with higher priority
-        if(nn > 0) for(Index i = 0; i < nb; ++i)
+        if(nn > 0 && !exact)
+            updateWithSwapsBlocked(w);
+        else if(nn > 0) for(Index i = 0; i < nb; ++i)
         {
-            Index j;
-            const double wi = w[ibasic[i]];
-            const double wj = find_nonbasic_candidate(i, j);
-            if(wi < wj)
-                updateWithSwapBasicVariable(i, j);
+            Index t;
+            const auto tol = exact ? 0.0 : pivotTolerance(S.row(i));
+            const auto j = findNonBasicCandidate(w, i, [&](Index c) {
+                return exact ? Sn(i, c) != 0 : std::abs(S(i, c)) > tol; }, t);
+            if(j == -1)
+                continue;
+            updateWithSwapBasicVariable(i, j);
+            updateColumnOrder(w, t, j);
         }
 
+        // Sort the columns of S again in case the swaps were replayed with a basic variable left out (see @ref replaySwaps)
+        sortByWeights(jorder.data(), nn, [&](Index j) { return w[inonbasic[j]]; });
+
         // Sort the basic variables in descend order of weights
-        std::sort(Kb.indices().data(), Kb.indices().data() + nb,
-            [&](Index l, Index r) { return w[ibasic[l]] > w[ibasic[r]]; });
+        Kb.setIdentity(nb);
+        sortByWeights(Kb.indices().data(), nb, [&](Index l) { return w[ibasic[l]]; });
 
-        // Sort the non-basic variables in descend order of weights
-        std::sort(Kn.indices().data(), Kn.indices().data() + nn,
-            [&](Index l, Index r) { return w[inonbasic[l]] > w[inonbasic[r]]; });
+        // Sort the non-basic variables in descend order of weights, which is the current order of the columns of S
+        Kn.setIdentity(nn);
+        std::copy(jorder.data(), jorder.data() + nn, Kn.indices().data());
 
-        // Rearrange the rows of S based on the new order of basic variables
-        Kb.transpose().applyThisOnTheLeft(S);
+        // Rearrange S, R, Q based on the new order of basic and non-basic variables
+        rearrange(Kb, Kn);
+    }
 
-        // Rearrange the columns of S based on the new order of non-basic variables
-        Kn.applyThisOnTheRight(S);
+    /// Rearrange S, the top `nb` rows of R, and Q based on new orders Kb and Kn of the basic and non-basic variables.
+    /// The rows and columns that change position are copied to the workspace first, because the in-place
+    /// application of the permutations allocates memory. The other rows and columns are not moved.
+    template<typename PermutationB, typename PermutationN>
+    auto rearrange(const PermutationB& Kb, const PermutationN& Kn) -> void
+    {
+        const auto nb = rankA;
+        const auto nn = Q.rows() - rankA;
 
-        // Rearrange the top `nb` rows of R based on the new order of basic variables
-        Kb.transpose().applyThisOnTheLeft(Rb);
+        const auto& kb = Kb.indices();
+        const auto& kn = Kn.indices();
 
-        // Rearrange the permutation matrix Q based on the new order of basic variables
-        Kb.transpose().applyThisOnTheLeft(ibasic);
+        // Rearrange the rows of S, the top `nb` rows of R and the head of Q based on the new order of basic variables
+        for(Index i = 0; i < nb; ++i)
+        {
+            if(kb[i] == i) continue;
+            Sw.row(i) = S.row(i);
+            Rw.row(i) = R.row(i);
+            Qw[i] = Q[i];
+            if(exact)
+            {
+                Snw.row(i) = Sn.row(i);
+                Rnw.row(i) = Rn.row(i);
+                dnw[i] = dn[i];
+            }
+        }
+        for(Index i = 0; i < nb; ++i)
+        {
+            if(kb[i] == i) continue;
+            S.row(i) = Sw.row(kb[i]);
+            R.row(i) = Rw.row(kb[i]);
+            Q[i] = Qw[kb[i]];
+            if(exact)
+            {
+                Sn.row(i) = Snw.row(kb[i]);
+                Rn.row(i) = Rnw.row(kb[i]);
+                dn[i] = dnw[kb[i]];
+            }
+        }
 
-        // Rearrange the permutation matrix Q based on the new order of non-basic variables
-        Kn.transpose().applyThisOnTheLeft(inonbasic);
+        // Rearrange the columns of S and the tail of Q based on the new order of non-basic variables
+        for(Index j = 0; j < nn; ++j)
+        {
+            if(kn[j] == j) continue;
+            Sw.col(j) = S.col(j);
+            Qw[nb + j] = Q[nb + j];
+            if(exact)
+                Snw.col(j) = Sn.col(j);
+        }
+        for(Index j = 0; j < nn; ++j)
+        {
+            if(kn[j] == j) continue;
+            S.col(j) = Sw.col(kn[j]);
+            Q[nb + j] = Qw[nb + kn[j]];
+            if(exact)
+                Sn.col(j) = Snw.col(kn[j]);
+        }
     }
 
     /// Reset to the canonical matrix form computed initially.
@@ -295,49 +1257,44 @@ struct Echelonizer::Impl
         R = R0;
         S = S0;
         Q = Q0;
+        exact = exact0;
+        if(exact)
+        {
+            Rn = Rn0;
+            Sn = Sn0;
+            dn = dn0;
+        }
+        Kb.setIdentity(rankA);
+        Kn.setIdentity(A.cols() - rankA);
+        drift = 0.0;
+        dirty = true;
     }
 
     /// Update the ordering of the basic and non-basic variables,
     auto updateOrdering(IndicesView Kb, IndicesView Kn) -> void
     {
-        const auto n  = Q.rows();
-        const auto nb = S.rows();
-        const auto nn = n - nb;
-
-        assert(nb == Kb.size());
-        assert(nn == Kn.size());
+        assert(S.rows() == Kb.size());
+        assert(Q.rows() - S.rows() == Kn.size());
 
-        // The top nb rows of R, since its remaining rows correspond to linearly dependent rows in A
-        auto Rt = R.topRows(nb);
-
-        // The indices of the basic and non-basic variables
-        auto ibasic = Q.head(nb);
-        auto inonbasic = Q.tail(nn);
-
-        // Rearrange the rows of S based on the new order of basic variables
-        Kb.asPermutation().transpose().applyThisOnTheLeft(S);
-
-        // Rearrange the columns of S based on the new order of non-basic variables
-        Kn.asPermutation().applyThisOnTheRight(S);
-
-        // Rearrange the top `nb` rows of R based on the new order of basic variables
-        Kb.asPermutation().transpose().applyThisOnTheLeft(Rt);
-
-        // Rearrange the permutation matrix Q based on the new order of basic variables
-        Kb.asPermutation().transpose().applyThisOnTheLeft(ibasic);
-
-        // Rearrange the permutation matrix Q based on the new order of non-basic variables
-        Kn.asPermutation().transpose().applyThisOnTheLeft(inonbasic);
+        // Rearrange S, R, Q based on the new order of basic and non-basic variables
+        rearrange(Kb.asPermutation(), Kn.asPermutation());
     }
 
     /// Perform a cleanup procedure to remove residual round-off errors from the canonical form.
     auto cleanResidualRoundoffErrors() -> void
     {
+        // The exact echelon form has no residual round-off errors, and
+        // those in R and S have already been cleaned if they have not changed
+        if(exact || !dirty)
+            return;
+
         S.array() += sigma;
         S.array() -= sigma;
 
         R.array() += sigma;
         R.array() -= sigma;
+
+        dirty = false;
     }
 };
 
@@ -366,12 +1323,12 @@ auto Echelonizer::operator=(Echelonizer other) -> Echelonizer&
 
 auto Echelonizer::numVariables() const -> Index
 {
-    return pimpl->lu.cols();
+    return pimpl->A.cols();
 }
 
 auto Echelonizer::numEquations() const -> Index
 {
-    return pimpl->lu.rows();
+    return pimpl->A.rows();
 }
 
 auto Echelonizer::numBasicVariables() const -> Index
@@ -399,6 +1356,11 @@ auto Echelonizer::Q() const -> IndicesView
     return pimpl->Q;
 }
 
+auto Echelonizer::isExact() const -> bool
+{
+    return pimpl->exact;
+}
+
 auto Echelonizer::C() const -> Matrix
 {
     const Index m  = numEquations();
@@ -429,6 +1391,11 @@ auto Echelonizer::compute(MatrixView A) -> void
     pimpl->compute(A);
 }
 
+auto Echelonizer::computeWithBasicVariables(MatrixView A, IndicesView ibasic) -> void
+{
+    pimpl->computeWithBasicVariables(A, ibasic);
+}
+
 auto Echelonizer::updateWithSwapBasicVariable(Index ibasic, Index inonbasic) -> void
 {
     pimpl->updateWithSwapBasicVariable(ibasic, inonbasic);
@@ -79,6 +79,11 @@ public:
     /// This method returns the indices (ordering) of the variables after canonicalization.
     auto Q() const -> IndicesView;
 
+    /// Return true if the canonical form is currently computed and updated with exact rational arithmetic.
+    /// This happens when the entries in matrix \eq{A} are small integers,
+    /// in which case \eq{R} and \eq{S} have no accumulated round-off errors.
+    auto isExact() const -> bool;
+
     /// Return the canonicalized matrix \eq{C = RAQ = [I\quad S]}`.
     auto C() const -> Matrix;
 
@@ -94,6 +99,19 @@ public:
     /// Compute the canonical matrix of the given matrix.
     auto compute(MatrixView A) -> void;
 
+    /// Compute the canonical matrix of the given matrix with given basic variables.
+    /// This method is an alternative to @ref compute for a matrix that changes
+    /// slightly between calls, so that the basic variables of its previous
+    /// canonical form can be reused. The canonical form is then computed with
+    /// an LU decomposition of the columns of these basic variables, which is
+    /// cheaper than the Gauss-Jordan elimination in @ref compute. The latter is
+    /// used instead if these columns do not form a square and well-conditioned
+    /// matrix, if the dimensions of the matrix have changed, or if its entries
+    /// are integers, for which the canonical form is computed exactly.
+    /// @param A The matrix to be echelonized.
+    /// @param ibasic The indices of the columns in *A* corresponding to the basic variables.
+    auto computeWithBasicVariables(MatrixView A, IndicesView ibasic) -> void;
+
     /// Update the canonical form with the swap of a basic variable by a non-basic variable.
     /// @param ibasic The index of the basic variable between 0 and \eq{n_\mathrm{b}}`.
     /// @param inonbasic The index of the non-basic variable between 0 and \eq{n_\mathrm{n}}`.
@@ -28,6 +28,18 @@ namespace Optima {
 
 struct EchelonizerExtended::Impl
 {
+    //======================================================================
+    // Note: The matrix J varies smoothly between consecutive calls to
+    // updateWithPriorityWeights, and the basic variables selected for
+    // J2 = J2 - J1*SA in the last call are usually still good ones for the
+    // new J2. These variables are thus stored (as indices of the variables
+    // in W, since the columns of J2 depend on the ordering of the non-basic
+    // variables of A) and given to echelonizerJ, which then avoids the pivot
+    // search of the Gauss-Jordan elimination of J2 if their columns are not
+    // ill-conditioned. The basic variable swaps performed next with the
+    // priority weights are then few, since the weights vary smoothly too.
+    //======================================================================
+
     /// The echelonizer for matrix A
     Echelonizer echelonizerA;
 
@@ -55,6 +67,51 @@ struct EchelonizerExtended::Impl
     /// subtract sigma, so that residual round-off errors are eliminated.
     double sigma;
 
+    /// The flag that indicates if the canonical form is the one of A in the echelonizer of A (i.e., when J is empty), which is then used without copying its R, S and Q.
+    bool onlyA = true;
+
+    /// The flag that indicates if R and S have changed since their last cleanup of residual round-off errors (not used if @ref onlyA is true).
+    bool dirty = true;
+
+    /// The constant matrix A in W = [A; J] used in the last initialization.
+    Matrix A;
+
+    /// The flag that indicates if the echelon form of A has been computed.
+    bool initialized = false;
+
+    /// The workspace for matrix J12 = J*QA = [J1 J2], with J2 then replaced by J2 - J1*SA.
+    Matrix J12;
+
+    /// The workspace for the priority weights of the non-basic variables with respect to A.
+    Vector w;
+
+    /// The indices of the variables in W that were basic with respect to J2 in the last update.
+    Indices ibasicJ;
+
+    /// The flag that indicates if the basic variables in @ref ibasicJ can be reused in the next update.
+    bool reuseJ = false;
+
+    /// The workspace for the positions of the variables in W among the non-basic variables with respect to A (-1 if basic).
+    Indices jposJ;
+
+    /// The workspace for the columns in J2 of the variables in @ref ibasicJ.
+    Indices jbasicJ;
+
+    /// The workspace for matrix SA12 = SA*QJ = [SA1 SA2], with SA2 then replaced by SA2 - SA1*SJ.
+    Matrix SA12;
+
+    /// The workspace for the auxiliary matrix products SA1*RJt, SA1*RJt*J1, RJt*J1, RJb*J1 used to compute R.
+    Matrix SA1RJt, SA1RJtJ1, RJtJ1, RJbJ1;
+
+    /// The workspace matrix used to rearrange the rows and columns of S without memory allocation.
+    Matrix Sw;
+
+    /// The workspace matrix used to rearrange the top rows of R without memory allocation.
+    Matrix Rw;
+
+    /// The workspace permutation matrix used to rearrange Q without memory allocation.
+    Indices Qw;
+
     /// Construct a default EchelonizerExtended::Impl object
     Impl()
     {
@@ -63,15 +120,44 @@ struct EchelonizerExtended::Impl
     /// Construct a EchelonizerExtended::Impl object with given matrix A
     Impl(MatrixView A)
     {
-        // Initialize the echelonizer for A (wait until J is provided to initialize echelonizerJ)
-        echelonizerA.compute(A);
-        R = echelonizerA.R();
-        S = echelonizerA.S();
-        Q = echelonizerA.Q();
-
-        // Compute sigma for given matrix A
-        sigma = A.size() ? A.cwiseAbs().maxCoeff() : 0.0;
-        sigma = A.size() ? std::pow(10, 1 + std::ceil(std::log10(sigma))) : 0.0; // TODO: In the future, consider a contribution from J to determine sigma (or find an alternative approach to remove round-off errors.)
+        initialize(A);
+    }
+
+    /// Initialize the canonical form with given constant matrix A in W = [A; J].
+    auto initialize(MatrixView Anew) -> void
+    {
+        // Reuse the echelon form of A if Anew is A, but reset it to avoid accumulated round-off errors
+        if(initialized && Anew.rows() == A.rows() && Anew.cols() == A.cols() && Anew == A)
+            reset();
+        else
+        {
+            // Start with a fresh echelonizer for J, as done for A below
+            echelonizerJ = Echelonizer();
+            reuseJ = false;
+
+            A = Anew;
+
+            // Initialize the echelonizer for A (wait until J is provided to initialize echelonizerJ)
+            echelonizerA.compute(A);
+
+            // Compute sigma for given matrix A
+            sigma = A.size() ? A.cwiseAbs().maxCoeff() : 0.0;
+            sigma = A.size() ? std::pow(10, 1 + std::ceil(std::log10(sigma))) : 0.0; // TODO: In the future, consider a contribution from J to determine sigma (or find an alternative approach to remove round-off errors.)
+
+            initialized = true;
+
+            onlyA = true;
+        }
+    }
+
+    /// Reset the canonical form to the echelon form of A computed in the last initialization.
+    auto reset() -> void
+    {
+        assert(initialized);
+        echelonizerJ = Echelonizer();
+        reuseJ = false;
+        echelonizerA.reset();
+        onlyA = true;
     }
 
     /// Update the canonical form with given variable matrix J in W = [A; J] and priority weights for the variables.
@@ -81,12 +167,13 @@ struct EchelonizerExtended::Impl
 
         if(J.size() == 0)
         {
-            R = echelonizerA.R();
-            S = echelonizerA.S();
-            Q = echelonizerA.Q();
+            onlyA = true;
             return;
         }
 
+        onlyA = false;
+        dirty = true;
+
         // FIXME: Investigate why EchelonizerExtended is not accurate when nz > 5 and fix it.
 
         const auto& RA = echelonizerA.R();
@@ -101,13 +188,17 @@ struct EchelonizerExtended::Impl
         const auto mJ = J.rows();
         const auto m = mA + mJ;
 
-        Matrix J12 = J * QA.asPermutation();
+        using Eigen::all;
+
+        // Note: the matrices below are computed into the workspace and with
+        // in-place products, so that no temporary matrices are allocated.
+        J12 = J(all, QA);
         auto J1 = J12.leftCols(nbA);
         auto J2 = J12.rightCols(nnA);
-        J2 -= J1 * SA;
+        J2.noalias() -= J1 * SA;
 
-        Vector w = weights(QA.tail(nnA));  // w has the weights only for non-basic variables wrt A
-        echelonizerJ.compute(J2);
+        w = weights(QA.tail(nnA));  // w has the weights only for non-basic variables wrt A
+        computeEchelonFormJ2(J2, QA.tail(nnA));
         echelonizerJ.updateWithPriorityWeights(w);
 
         const auto nbJ = echelonizerJ.numBasicVariables();
@@ -123,15 +214,20 @@ struct EchelonizerExtended::Impl
         const auto SJ = echelonizerJ.S();
         const auto QJ = echelonizerJ.Q();
 
+        // Store the basic variables of J2 for the next update, which are reused only if they form a square matrix
+        ibasicJ.resize(mJ);
+        for(Index k = 0; k < nbJ; ++k)
+            ibasicJ[k] = QA[nbA + QJ[k]];
+        reuseJ = nbJ == mJ;
+
         Q.resize(n);
         Q.head(nbA) = QA.head(nbA);
         Q.tail(nnA) = QA.tail(nnA)(QJ);
 
-        Matrix SA12 = SA;
-        QJ.asPermutation().applyThisOnTheRight(SA12);
+        SA12 = SA(all, QJ);
         auto SA1 = SA12.leftCols(nbJ);
         auto SA2 = SA12.rightCols(nnJ);
-        SA2 -= SA1 * SJ;
+        SA2.noalias() -= SA1 * SJ;
 
         S.resize(nbA + nbJ, nnJ);
         S.topRows(nbA) = SA2;
@@ -148,14 +244,22 @@ struct EchelonizerExtended::Impl
         auto Rt = R.topRows(nbA + nbJ);
         auto Rb = R.bottomRows(m - nbA - nbJ);
 
-        Rt.topLeftCorner(nbA, mA) = RAt + SA1*RJt*J1*RAt;
+        SA1RJt.noalias() = SA1*RJt;
+        SA1RJtJ1.noalias() = SA1RJt*J1;
+        RJtJ1.noalias() = RJt*J1;
+        RJbJ1.noalias() = RJb*J1;
+
+        Rt.topLeftCorner(nbA, mA) = RAt;
+        Rt.topLeftCorner(nbA, mA).noalias() += SA1RJtJ1*RAt;
         Rb.topLeftCorner(mA - nbA, mA) = RAb;
 
-        Rt.topRightCorner(nbA, mJ) = -SA1*RJt;
+        Rt.topRightCorner(nbA, mJ) = -SA1RJt;
         Rb.topRightCorner(mA - nbA, mJ).fill(0.0);
 
-        Rt.bottomLeftCorner(nbJ, mA) = -RJt*J1*RAt;
-        Rb.bottomLeftCorner(mJ - nbJ, mA) = -RJb*J1*RAt;
+        Rt.bottomLeftCorner(nbJ, mA).setZero();
+        Rt.bottomLeftCorner(nbJ, mA).noalias() -= RJtJ1*RAt;
+        Rb.bottomLeftCorner(mJ - nbJ, mA).setZero();
+        Rb.bottomLeftCorner(mJ - nbJ, mA).noalias() -= RJbJ1*RAt;
 
         Rt.bottomRightCorner(nbJ, mJ) = RJt;
         Rb.bottomRightCorner(mJ - nbJ, mJ) = RJb;
@@ -175,71 +279,143 @@ struct EchelonizerExtended::Impl
         auto ibasic = Q.head(nb);
         auto inonbasic = Q.tail(nn);
 
-        // Sort the basic variables in descend order of weights
+        // Sort the basic variables in descend order of weights (ties in ascend order of position, for a deterministic ordering)
         std::sort(Kb.indices().data(), Kb.indices().data() + nb,
-            [&](Index l, Index r) { return weights[ibasic[l]] > weights[ibasic[r]]; });
+            [&](Index l, Index r) { return weights[ibasic[l]] > weights[ibasic[r]] || (weights[ibasic[l]] == weights[ibasic[r]] && l < r); });
 
-        // Sort the non-basic variables in descend order of weights
+        // Sort the non-basic variables in descend order of weights (ties in ascend order of position, for a deterministic ordering)
         std::sort(Kn.indices().data(), Kn.indices().data() + nn,
-            [&](Index l, Index r) { return weights[inonbasic[l]] > weights[inonbasic[r]]; });
+            [&](Index l, Index r) { return weights[inonbasic[l]] > weights[inonbasic[r]] || (weights[inonbasic[l]] == weights[inonbasic[r]] && l < r); });
+
+        // Rearrange S, R, Q based on the new order of basic and non-basic variables
+        rearrange(Kb, Kn);
+    }
 
-        // Rearrange the rows of S based on the new order of basic variables
-        Kb.transpose().applyThisOnTheLeft(S);
+    /// Compute the echelon form of J2 reusing the basic variables of the last update if they are still non-basic with respect to A.
+    /// @param J2 The matrix J2 whose echelon form is computed.
+    /// @param inonbasicA The indices of the variables in W that are non-basic with respect to A, corresponding to the columns of J2.
+    auto computeEchelonFormJ2(MatrixView J2, IndicesView inonbasicA) -> void
+    {
+        const auto n = echelonizerA.numVariables();
+        const auto nbJ = J2.rows();
+
+        jposJ.resize(n);
+        jbasicJ.resize(nbJ);
 
-        // Rearrange the columns of S based on the new order of non-basic variables
-        Kn.applyThisOnTheRight(S);
+        if(!reuseJ || ibasicJ.size() != nbJ)
+            return echelonizerJ.compute(J2);
 
-        // Rearrange the top `nb` rows of R based on the new order of basic variables
-        Kb.transpose().applyThisOnTheLeft(Rt);
+        jposJ.fill(-1);
+        for(Index k = 0; k < inonbasicA.size(); ++k)
+            jposJ[inonbasicA[k]] = k;
 
-        // Rearrange the permutation matrix Q based on the new order of basic variables
-        Kb.transpose().applyThisOnTheLeft(ibasic);
+        for(Index k = 0; k < nbJ; ++k)
+        {
+            jbasicJ[k] = jposJ[ibasicJ[k]];
+            if(jbasicJ[k] == -1) // this variable has become basic with respect to A
+                return echelonizerJ.compute(J2);
+        }
 
-        // Rearrange the permutation matrix Q based on the new order of non-basic variables
-        Kn.transpose().applyThisOnTheLeft(inonbasic);
+        echelonizerJ.computeWithBasicVariables(J2, jbasicJ);
     }
 
     /// Update the ordering of the basic and non-basic variables,
     auto updateOrdering(IndicesView Kb, IndicesView Kn) -> void
     {
-        const auto n  = Q.rows();
-        const auto nb = S.rows();
-        const auto nn = n - nb;
+        if(onlyA)
+            return echelonizerA.updateOrdering(Kb, Kn);
 
-        assert(nb == Kb.size());
-        assert(nn == Kn.size());
+        assert(S.rows() == Kb.size());
+        assert(Q.rows() - S.rows() == Kn.size());
 
-        // The top nb rows of R, since its remaining rows correspond to linearly dependent rows in [A; J]
-        auto Rt = R.topRows(nb);
-
-        // The indices of the basic and non-basic variables
-        auto ibasic = Q.head(nb);
-        auto inonbasic = Q.tail(nn);
+        // Rearrange S, R, Q based on the new order of basic and non-basic variables
+        rearrange(Kb.asPermutation(), Kn.asPermutation());
+    }
 
-        // Rearrange the rows of S based on the new order of basic variables
-        Kb.asPermutation().transpose().applyThisOnTheLeft(S);
+    /// Rearrange S, the top `nb` rows of R, and Q based on new orders Kb and Kn of the basic and non-basic variables.
+    /// The rows and columns that change position are copied to the workspace first, because the in-place
+    /// application of the permutations allocates memory. The other rows and columns are not moved.
+    template<typename PermutationB, typename PermutationN>
+    auto rearrange(const PermutationB& Kb, const PermutationN& Kn) -> void
+    {
+        const auto n  = Q.rows();
+        const auto nb = S.rows();
+        const auto nn = n - nb;
 
-        // Rearrange the columns of S based on the new order of non-basic variables
-        Kn.asPermutation().applyThisOnTheRight(S);
+        const auto& kb = Kb.indices();
+        const auto& kn = Kn.indices();
 
-        // Rearrange the top `nb` rows of R based on the new order of basic variables
-        Kb.asPermutation().transpose().applyThisOnTheLeft(Rt);
+        Sw.resize(nb, nn);
+        Rw.resize(nb, R.cols());
+        Qw.resize(n);
 
-        // Rearrange the permutation matrix Q based on the new order of basic variables
-        Kb.asPermutation().transpose().applyThisOnTheLeft(ibasic);
+        // Rearrange the rows of S, the top `nb` rows of R and the head of Q based on the new order of basic variables
+        for(Index i = 0; i < nb; ++i)
+        {
+            if(kb[i] == i) continue;
+            Sw.row(i) = S.row(i);
+            Rw.row(i) = R.row(i);
+            Qw[i] = Q[i];
+        }
+        for(Index i = 0; i < nb; ++i)
+        {
+            if(kb[i] == i) continue;
+            S.row(i) = Sw.row(kb[i]);
+            R.row(i) = Rw.row(kb[i]);
+            Q[i] = Qw[kb[i]];
+        }
 
-        // Rearrange the permutation matrix Q based on the new order of non-basic variables
-        Kn.asPermutation().transpose().applyThisOnTheLeft(inonbasic);
+        // Rearrange the columns of S and the tail of Q based on the new order of non-basic variables
+        for(Index j = 0; j < nn; ++j)
+        {
+            if(kn[j] == j) continue;
+            Sw.col(j) = S.col(j);
+            Qw[nb + j] = Q[nb + j];
+        }
+        for(Index j = 0; j < nn; ++j)
+        {
+            if(kn[j] == j) continue;
+            S.col(j) = Sw.col(kn[j]);
+            Q[nb + j] = Qw[nb + kn[j]];
+        }
     }
 
     /// Perform a cleanup procedure to remove residual round-off errors from the canonical form.
     auto cleanResidualRoundoffErrors() -> void
     {
+        // The echelonizer of A cleans its own canonical form only if it has changed since its last cleanup
+        if(onlyA)
+            return echelonizerA.cleanResidualRoundoffErrors();
+
+        // The canonical form has already been cleaned if it has not changed
+        if(!dirty)
+            return;
+
         S.array() += sigma;
         S.array() -= sigma;
 
         R.array() += sigma;
         R.array() -= sigma;
+
+        dirty = false;
+    }
+
+    /// Return the matrix S of the current canonical form.
+    auto matrixS() const -> MatrixView
+    {
+        return onlyA ? echelonizerA.S() : MatrixView(S);
+    }
+
+    /// Return the matrix R of the current canonical form.
+    auto matrixR() const -> MatrixView
+    {
+        return onlyA ? echelonizerA.R() : MatrixView(R);
+    }
+
+    /// Return the permutation matrix Q of the current canonical form.
+    auto matrixQ() const -> IndicesView
+    {
+        return onlyA ? echelonizerA.Q() : IndicesView(Q);
     }
 };
 
@@ -268,7 +444,7 @@ auto EchelonizerExtended::operator=(EchelonizerExtended other) -> EchelonizerExt
 
 auto EchelonizerExtended::numVariables() const -> Index
 {
-    return pimpl->Q.rows();
+    return pimpl->matrixQ().rows();
 }
 
 auto EchelonizerExtended::numEquations() const -> Index
@@ -278,7 +454,7 @@ auto EchelonizerExtended::numEquations() const -> Index
 
 auto EchelonizerExtended::numBasicVariables() const -> Index
 {
-    return pimpl->S.rows();
+    return pimpl->matrixS().rows();
 }
 
 auto EchelonizerExtended::numNonBasicVariables() const -> Index
@@ -288,17 +464,17 @@ auto EchelonizerExtended::numNonBasicVariables() const -> Index
 
 auto EchelonizerExtended::S() const -> MatrixView
 {
-    return pimpl->S;
+    return pimpl->matrixS();
 }
 
 auto EchelonizerExtended::R() const -> MatrixView
 {
-    return pimpl->R;
+    return pimpl->matrixR();
 }
 
 auto EchelonizerExtended::Q() const -> IndicesView
 {
-    return pimpl->Q;
+    return pimpl->matrixQ();
 }
 
 auto EchelonizerExtended::C() const -> Matrix
@@ -316,13 +492,23 @@ auto EchelonizerExtended::C() const -> Matrix
 auto EchelonizerExtended::indicesBasicVariables() const -> IndicesView
 {
     const auto nb = numBasicVariables();
-    return pimpl->Q.head(nb);
+    return pimpl->matrixQ().head(nb);
 }
 
 auto EchelonizerExtended::indicesNonBasicVariables() const -> IndicesView
 {
     const auto nn = numNonBasicVariables();
-    return pimpl->Q.tail(nn);
+    return pimpl->matrixQ().tail(nn);
+}
+
+auto EchelonizerExtended::initialize(MatrixView A) -> void
+{
+    pimpl->initialize(A);
+}
+
+auto EchelonizerExtended::reset() -> void
+{
+    pimpl->reset();
 }
 
 auto EchelonizerExtended::updateWithPriorityWeights(MatrixView J, VectorView weights) -> void
@@ -93,6 +93,16 @@ public:
     /// Return the indices of the non-basic variables.
     auto indicesNonBasicVariables() const -> IndicesView;
 
+    /// Initialize the canonical form with given constant matrix *A* in *W = [A; J]*.
+    /// If *A* is identical to the matrix given in the previous call, its
+    /// echelonization is not performed again. Instead, the echelon form is
+    /// reset to the one computed initially for *A*, which removes the
+    /// round-off errors accumulated during basic variable swaps since then.
+    auto initialize(MatrixView A) -> void;
+
+    /// Reset the canonical form to the echelon form of *A* computed in the last call to @ref initialize.
+    auto reset() -> void;
+
     /// Update the canonical form with given lower matrix block *J* and priority weights for the variables.
     auto updateWithPriorityWeights(MatrixView J, VectorView weights) -> void;
 
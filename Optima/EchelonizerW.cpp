@@ -32,6 +32,9 @@ struct EchelonizerW::Impl
     /// The matrices Ax, Ap, W = [Ax Ap; Jx Jp], S = [Sbn Sbp]
     Matrix W, S;
 
+    /// The workspace for the product Rl*Wp, which should be zero, where Rl are the bottom rows of R for linearly dependent rows in W.
+    Matrix RlWp;
+
     /// The echelonizer of matrix Wx = [Ax; Jx]
     EchelonizerExtended echelonizer;
 
@@ -49,11 +52,8 @@ struct EchelonizerW::Impl
         assert(Ap.rows() == ny || ny == 0 || np == 0);
         assert(Ap.cols() == np || ny == 0 || np == 0);
 
-        // TODO: Implement a sort of memoization here to avoid echelonization of same Ax.
-        // If same as last time, instead of creating a new echelonizer, we call echelonizer.initialize(Ax)
-        // where EchelonizerExtended::initialize should figure out if same. Careful with echelon form that has
-        // been contaminated with round off errors (because there has been many basic swaps already).
-        echelonizer = EchelonizerExtended(Ax);
+        // Avoid a new echelonization of Ax if it is the same as in the previous initialization.
+        echelonizer.initialize(Ax);
 
         W.resize(nw, nx + np);
         S.resize(nw, nx + np);
@@ -65,6 +65,11 @@ struct EchelonizerW::Impl
         if(Ap.size()) Wp.topRows(ny) = Ap;
     }
 
+    auto reset() -> void
+    {
+        echelonizer.reset();
+    }
+
     auto update(MatrixView Jx, MatrixView Jp, VectorView weights) -> void
     {
         const auto [nx, np, ny, nz, nw, nt] = dims;
@@ -110,12 +115,14 @@ struct EchelonizerW::Impl
         auto Sbp = S.topRightCorner(nb, np);
 
         Sbn = echelonizer.S();
-        Sbp = Rb * Wp;
+        Sbp.noalias() = Rb * Wp;
 
         cleanResidualRoundoffErrors(Sbp);
 
-        const auto Rl = echelonizer.R().bottomRows(nw - nb);
-        errorif( norminf(Rl * Wp) > epsilon(),
+        const auto Rl = R.bottomRows(nw - nb);
+        RlWp.resize(nw - nb, np);
+        RlWp.noalias() = Rl * Wp;
+        errorif( norminf(RlWp) > epsilon(),
             "Your matrix Ax is rank-deficient and matrix Ap "
             "is non-zero such that R*Ap = [Sbp, Slp] with Slp non-zero, "
             "but it should be zero, otherwise there are p variables that "
@@ -174,6 +181,11 @@ auto EchelonizerW::initialize(const MasterDims& dims, MatrixView Ax, MatrixView
     pimpl->initialize(dims, Ax, Ap);
 }
 
+auto EchelonizerW::reset() -> void
+{
+    pimpl->reset();
+}
+
 auto EchelonizerW::update(MatrixView Jx, MatrixView Jp, VectorView weights) -> void
 {
     pimpl->update(Jx, Jp, weights);
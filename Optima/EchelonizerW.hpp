@@ -51,6 +51,9 @@ public:
     /// Initialize only once the *Ax* and *Ap* matrices in case these seldom change.
     auto initialize(const MasterDims& dims, MatrixView Ax, MatrixView Ap) -> void;
 
+    /// Reset the echelon form of *W* to the one of *Ax* and *Ap* computed in the last call to @ref initialize.
+    auto reset() -> void;
+
     /// Update the echelon form of matrix *W* where only *Jx* and *Jp* have changed.
     auto update(MatrixView Jx, MatrixView Jp, VectorView weights) -> void;
 
@@ -0,0 +1,50 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "HeapAllocationGuard.hpp"
+
+// Eigen includes
+#include <Eigen/Core>
+
+namespace Optima {
+
+#ifdef EIGEN_RUNTIME_NO_MALLOC
+
+HeapAllocationGuard::HeapAllocationGuard(bool allowed)
+: previous(Eigen::internal::is_malloc_allowed())
+{
+    Eigen::internal::set_is_malloc_allowed(allowed);
+}
+
+HeapAllocationGuard::~HeapAllocationGuard()
+{
+    Eigen::internal::set_is_malloc_allowed(previous);
+}
+
+#else
+
+HeapAllocationGuard::HeapAllocationGuard(bool)
+: previous(true)
+{}
+
+HeapAllocationGuard::~HeapAllocationGuard()
+{}
+
+#endif
+
+} // namespace Optima
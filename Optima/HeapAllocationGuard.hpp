@@ -0,0 +1,51 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+namespace Optima {
+
+/// Used to allow or forbid heap allocations by Eigen within a scope.
+/// The previous setting is restored when this object is destroyed. This has
+/// effect only when Optima is compiled with `EIGEN_RUNTIME_NO_MALLOC` (see the
+/// CMake option of same name), in which case any heap allocation performed by
+/// Eigen while these are forbidden fails an assertion. This is used to verify
+/// that the iterations of the optimization calculations do not allocate memory
+/// once their workspace has been initialized. Note that the setting is global
+/// in Eigen, and so this test mode should be used in single-threaded runs.
+class HeapAllocationGuard
+{
+public:
+    /// Construct a HeapAllocationGuard instance that allows or forbids heap allocations.
+    explicit HeapAllocationGuard(bool allowed);
+
+    /// Destroy this HeapAllocationGuard instance, restoring the previous setting.
+    ~HeapAllocationGuard();
+
+    /// Disable copy construction of HeapAllocationGuard instances.
+    HeapAllocationGuard(const HeapAllocationGuard&) = delete;
+
+    /// Disable copy assignment of HeapAllocationGuard instances.
+    auto operator=(const HeapAllocationGuard&) -> HeapAllocationGuard& = delete;
+
+private:
+    /// The setting for heap allocations before this object was created.
+    bool previous;
+};
+
+} // namespace Optima
@@ -0,0 +1,429 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "LDLT.hpp"
+
+// C++ includes
+#include <cassert>
+#include <cmath>
+
+// Optima includes
+#include <Optima/Utils.hpp>
+
+namespace Optima {
+
+struct LDLT::Impl
+{
+    //======================================================================
+    // Note: The decomposition below follows the blocked Bunch-Kaufman
+    // algorithm in LAPACK's dsytrf/dlasyf, using only the lower triangular
+    // part of the matrix. At every step, either a 1x1 or a 2x2 pivot is
+    // chosen so that the growth of the entries in L is bounded, which makes
+    // the decomposition stable for symmetric indefinite matrices (e.g., the
+    // saddle-point matrices in the linear problems). The columns are
+    // processed in panels of width `nb`, with the updates of the columns in
+    // a panel computed from the columns of L*D stored in workspace W, so
+    // that the trailing matrix is updated once per panel with a matrix-matrix
+    // product that computes only its lower triangular part. The row and
+    // column interchanges are not applied to the columns of L in previous
+    // steps, but recorded so that they are applied in sequence when solving.
+    // As in class LU, the decomposition is performed in the top-left corner
+    // of a workspace matrix whose dimensions never shrink, and it is rejected
+    // if the estimated reciprocal condition number of the matrix is small,
+    // since Bunch-Kaufman pivoting cannot resolve singular matrices as the
+    // full-pivoting LU decomposition does.
+    //======================================================================
+
+    /// The estimated reciprocal condition number below which the decomposition is rejected.
+    static constexpr double rcondmin = 1e-8;
+
+    /// The Bunch-Kaufman constant (1 + sqrt(17))/8 that bounds the element growth in the decomposition.
+    static constexpr double alpha = 0.64038820320220756872767623199676;
+
+    /// The number of columns in the panels of the blocked decomposition.
+    static constexpr Index nb = 32;
+
+    /// The workspace whose top-left corner contains the factors L and D of the last decomposed matrix.
+    Matrix LDw;
+
+    /// The pivots of the decomposition (as in LAPACK, negative for the two rows of a 2x2 pivot).
+    Indices piv;
+
+    /// The dimension of the last decomposed matrix.
+    Index n = 0;
+
+    /// The numbers of positive, negative, and zero eigenvalues of the last decomposed matrix.
+    std::array<Index, 3> inertia = {};
+
+    /// The workspace for the updated columns of the current panel of the decomposition.
+    Matrix Ww;
+
+    /// The workspace for the vectors used in the estimation of the reciprocal condition number.
+    Matrix rcondw;
+
+    /// Construct a default Impl object.
+    Impl()
+    {}
+
+    /// Return true if empty.
+    auto empty() const -> bool
+    {
+        return n == 0;
+    }
+
+    /// Compute the LDLT decomposition of the given symmetric matrix.
+    auto decompose(MatrixView A) -> bool
+    {
+        assert(A.rows() == A.cols());
+
+        n = A.rows();
+
+        ensureMinimumDimension(LDw, n, n);
+        ensureMinimumDimension(piv, n);
+        ensureMinimumDimension(Ww, n, nb);
+        ensureMinimumDimension(rcondw, n, 3);
+
+        inertia = {};
+
+        if(n == 0)
+            return true;
+
+        auto M = LDw.topLeftCorner(n, n);
+
+        M.triangularView<Eigen::Lower>() = A;
+
+        // The 1-norm of the symmetric matrix, computed from its lower triangular part
+        auto colsums = rcondw.col(0).head(n);
+        colsums.fill(0.0);
+        for(Index j = 0; j < n; ++j)
+        {
+            colsums[j] += std::abs(M(j, j));
+            for(Index i = j + 1; i < n; ++i)
+            {
+                colsums[j] += std::abs(M(i, j));
+                colsums[i] += std::abs(M(i, j));
+            }
+        }
+        const auto Anorm = colsums.maxCoeff();
+
+        for(Index j0 = 0; j0 < n; )
+        {
+            const auto j1 = decomposePanel(j0);
+            if(j1 < 0)
+                return false; // the matrix is singular
+            j0 = j1;
+        }
+
+        for(Index k = 0; k < n; )
+        {
+            if(piv[k] >= 0)
+            {
+                inertia[M(k, k) > 0.0 ? 0 : 1] += 1;
+                k += 1;
+            }
+            else
+            {
+                const auto det = M(k, k) * M(k + 1, k + 1) - M(k + 1, k) * M(k + 1, k);
+                if(det < 0.0) { inertia[0] += 1; inertia[1] += 1; }
+                else if(det > 0.0) inertia[M(k, k) > 0.0 ? 0 : 1] += 2;
+                else { inertia[2] += 1; inertia[M(k, k) + M(k + 1, k + 1) > 0.0 ? 0 : 1] += 1; }
+                k += 2;
+            }
+        }
+
+        return rcond(Anorm) >= rcondmin;
+    }
+
+    /// Decompose the columns of the panel starting at column `j0` and update the trailing matrix.
+    /// @return The first column after the panel, or -1 if the matrix is singular.
+    auto decomposePanel(Index j0) -> Index
+    {
+        auto M = LDw.topLeftCorner(n, n);
+        auto W = Ww.topRows(n);
+
+        const auto last = n - j0 <= nb; // true if the panel covers all remaining columns
+
+        Index k = j0;
+        while(k < n && (last || k - j0 < nb - 1))
+        {
+            const auto c = k - j0; // the column in W corresponding to column k
+            const auto m = n - k;
+
+            // The column k of the matrix updated with the previous columns in the panel
+            W.col(c).tail(m) = M.col(k).tail(m);
+            W.col(c).tail(m).noalias() -= M.block(k, j0, m, c) * tr(W.row(k).head(c));
+
+            Index kstep = 1;
+            Index kp = k;
+
+            const auto absakk = std::abs(W(k, c));
+
+            Index imax = k;
+            const auto colmax = m > 1 ? W.col(c).tail(m - 1).cwiseAbs().maxCoeff(&imax) : 0.0;
+            imax += k + 1;
+
+            if(std::max(absakk, colmax) == 0.0)
+                return -1;
+
+            if(absakk < alpha * colmax)
+            {
+                // The column imax of the matrix updated with the previous columns in the panel
+                W.col(c + 1).segment(k, imax - k) = tr(M.row(imax).segment(k, imax - k));
+                W.col(c + 1).tail(n - imax) = M.col(imax).tail(n - imax);
+                W.col(c + 1).tail(m).noalias() -= M.block(k, j0, m, c) * tr(W.row(imax).head(c));
+
+                auto rowmax = W.col(c + 1).segment(k, imax - k).cwiseAbs().maxCoeff();
+                if(imax < n - 1)
+                    rowmax = std::max(rowmax, W.col(c + 1).tail(n - imax - 1).cwiseAbs().maxCoeff());
+
+                if(absakk >= alpha * colmax * (colmax / rowmax))
+                    kp = k;
+                else if(std::abs(W(imax, c + 1)) >= alpha * rowmax)
+                {
+                    kp = imax;
+                    W.col(c).tail(m) = W.col(c + 1).tail(m);
+                }
+                else
+                {
+                    kp = imax;
+                    kstep = 2;
+                }
+            }
+
+            const auto kk = k + kstep - 1;
+
+            // Interchange rows and columns kk and kp, where the not yet updated
+            // column kk of the matrix is discarded since it is already in W
+            if(kp != kk)
+            {
+                M(kp, kp) = M(kk, kk);
+                for(Index j = kk + 1; j < kp; ++j)
+                    M(kp, j) = M(j, kk);
+                if(kp < n - 1)
+                    M.col(kp).tail(n - kp - 1) = M.col(kk).tail(n - kp - 1);
+                M.row(kk).segment(j0, kk - j0).swap(M.row(kp).segment(j0, kk - j0));
+                W.row(kk).head(kk - j0 + 1).swap(W.row(kp).head(kk - j0 + 1));
+            }
+
+            if(kstep == 1)
+            {
+                M.col(k).tail(m) = W.col(c).tail(m);
+                M.col(k).tail(m - 1) /= M(k, k);
+                piv[k] = kp;
+            }
+            else
+            {
+                const auto a21 = W(k + 1, c);
+                const auto d11 = W(k + 1, c + 1) / a21;
+                const auto d22 = W(k, c) / a21;
+                const auto d21 = 1.0 / (d11 * d22 - 1.0) / a21;
+
+                M.col(k).tail(m - 2) = d21 * (d11 * W.col(c).tail(m - 2) - W.col(c + 1).tail(m - 2));
+                M.col(k + 1).tail(m - 2) = d21 * (d22 * W.col(c + 1).tail(m - 2) - W.col(c).tail(m - 2));
+
+                M(k, k) = W(k, c);
+                M(k + 1, k) = W(k + 1, c);
+                M(k + 1, k + 1) = W(k + 1, c + 1);
+
+                piv[k] = piv[k + 1] = -(kp + 1);
+            }
+
+            k += kstep;
+        }
+
+        // Update the lower triangular part of the trailing matrix with the columns in the panel
+        const auto kb = k - j0;
+        const auto m = n - k;
+        if(m > 0)
+            M.bottomRightCorner(m, m).triangularView<Eigen::Lower>() -= M.block(k, j0, m, kb) * tr(W.block(k, 0, m, kb));
+
+        // Undo the interchanges in the columns of L in the panel, so that
+        // every interchange is applied only to the subsequent columns
+        for(Index j = k - 1; j > j0; )
+        {
+            const auto jj = j;
+            auto jp = piv[j];
+            if(jp < 0) { jp = -jp - 1; --j; }
+            --j;
+            if(jp != jj && j >= j0)
+                M.row(jp).segment(j0, j - j0 + 1).swap(M.row(jj).segment(j0, j - j0 + 1));
+        }
+
+        return k;
+    }
+
+    /// Return an estimate of the reciprocal condition number of the last decomposed matrix in the 1-norm.
+    /// This uses Hager's method to estimate the 1-norm of the inverse matrix from a few solves with the LDLT factors.
+    /// @param Anorm The 1-norm of the last decomposed matrix.
+    auto rcond(double Anorm) -> double
+    {
+        if(Anorm == 0.0)
+            return 0.0;
+
+        auto x = rcondw.col(0).head(n);
+        auto y = rcondw.col(1).head(n);
+        auto z = rcondw.col(2).head(n);
+
+        x.fill(1.0 / n);
+
+        double Ainvnorm = 0.0;
+
+        for(auto iter = 0; iter < 5; ++iter)
+        {
+            y = x;
+            solveMultiple(y);
+            Ainvnorm = y.lpNorm<1>();
+
+            for(Index i = 0; i < n; ++i)
+                z[i] = y[i] >= 0.0 ? 1.0 : -1.0;
+            solveMultiple(z); // the matrix is symmetric, so no solve with its transpose is needed
+
+            Index j;
+            const auto zmax = z.cwiseAbs().maxCoeff(&j);
+
+            if(zmax <= z.dot(x))
+                break;
+
+            x.fill(0.0);
+            x[j] = 1.0;
+        }
+
+        const auto res = 1.0 / (Anorm * Ainvnorm);
+
+        return std::isfinite(res) ? res : 0.0;
+    }
+
+    /// Solve the linear systems `A*X = B` in-place using the LDLT decomposition obtained with @ref decompose.
+    template<typename MatrixType>
+    auto solveMultiple(MatrixType&& X) const -> void
+    {
+        assert(n == X.rows());
+
+        const auto M = LDw.topLeftCorner(n, n);
+
+        // Solve L*D*Y = P*B, applying the interchanges in sequence
+        Index k = 0;
+        while(k < n)
+        {
+            if(piv[k] >= 0)
+            {
+                const auto kp = piv[k];
+                if(kp != k) X.row(k).swap(X.row(kp));
+                const auto m = n - k - 1;
+                X.bottomRows(m).noalias() -= M.col(k).tail(m) * X.row(k);
+                X.row(k) /= M(k, k);
+                k += 1;
+            }
+            else
+            {
+                const auto kp = -piv[k] - 1;
+                if(kp != k + 1) X.row(k + 1).swap(X.row(kp));
+                const auto m = n - k - 2;
+                X.bottomRows(m).noalias() -= M.block(k + 2, k, m, 2) * X.middleRows(k, 2);
+                const auto a21 = M(k + 1, k);
+                const auto d11 = M(k, k) / a21;
+                const auto d22 = M(k + 1, k + 1) / a21;
+                const auto denom = d11 * d22 - 1.0;
+                for(Index j = 0; j < X.cols(); ++j)
+                {
+                    const auto b1 = X(k, j) / a21;
+                    const auto b2 = X(k + 1, j) / a21;
+                    X(k, j) = (d22 * b1 - b2) / denom;
+                    X(k + 1, j) = (d11 * b2 - b1) / denom;
+                }
+                k += 2;
+            }
+        }
+
+        // Solve tr(L)*tr(P)*X = Y, applying the interchanges in reverse sequence
+        k = n - 1;
+        while(k >= 0)
+        {
+            const auto m = n - k - 1;
+            if(piv[k] >= 0)
+            {
+                X.row(k).noalias() -= tr(M.col(k).tail(m)) * X.bottomRows(m);
+                const auto kp = piv[k];
+                if(kp != k) X.row(k).swap(X.row(kp));
+                k -= 1;
+            }
+            else
+            {
+                X.middleRows(k - 1, 2).noalias() -= tr(M.block(k + 1, k - 1, m, 2)) * X.bottomRows(m);
+                const auto kp = -piv[k] - 1;
+                if(kp != k) X.row(k).swap(X.row(kp));
+                k -= 2;
+            }
+        }
+    }
+};
+
+LDLT::LDLT()
+: pimpl(new Impl())
+{}
+
+LDLT::LDLT(const LDLT& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+LDLT::~LDLT()
+{}
+
+auto LDLT::operator=(LDLT other) -> LDLT&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto LDLT::empty() const -> bool
+{
+    return pimpl->empty();
+}
+
+auto LDLT::decompose(MatrixView A) -> bool
+{
+    return pimpl->decompose(A);
+}
+
+auto LDLT::solve(VectorView b, VectorRef x) -> void
+{
+    x = b;
+    pimpl->solveMultiple(x);
+}
+
+auto LDLT::solve(VectorRef x) -> void
+{
+    pimpl->solveMultiple(x);
+}
+
+auto LDLT::solveMultiple(MatrixView B, MatrixRef X) -> void
+{
+    X = B;
+    pimpl->solveMultiple(X);
+}
+
+auto LDLT::solveMultiple(MatrixRef X) -> void
+{
+    pimpl->solveMultiple(X);
+}
+
+auto LDLT::inertia() const -> std::array<Index, 3>
+{
+    return pimpl->inertia;
+}
+
+} // namespace Optima
@@ -0,0 +1,84 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <array>
+#include <memory>
+
+// Optima includes
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+/// A class for the solution of symmetric indefinite linear systems using LDLT decomposition.
+/// The decomposition *P*A*tr(P) = L*D*tr(L)* is computed with the
+/// Bunch-Kaufman pivoting strategy, where *L* is unit lower triangular and
+/// *D* is block diagonal with blocks of dimension one or two. Only the lower
+/// triangular part of the decomposed matrix is used.
+struct LDLT
+{
+    /// Construct a default LDLT object.
+    LDLT();
+
+    /// Construct a copy of an LDLT object.
+    LDLT(const LDLT& other);
+
+    /// Destroy this LDLT object.
+    virtual ~LDLT();
+
+    /// Assign an LDLT object to this.
+    auto operator=(LDLT other) -> LDLT&;
+
+    /// Return true if empty.
+    auto empty() const -> bool;
+
+    /// Compute the LDLT decomposition of the given symmetric matrix.
+    /// @return False if the matrix is singular or ill-conditioned, in which case the decomposition should not be used for solving linear systems.
+    auto decompose(MatrixView A) -> bool;
+
+    /// Solve the linear system `A*x = b` using the LDLT decomposition obtained with @ref decompose.
+    /// @note Ensure method @ref decompose has been called before this method.
+    auto solve(VectorView b, VectorRef x) -> void;
+
+    /// Solve the linear system `A*x = b` using the LDLT decomposition obtained with @ref decompose.
+    /// @param[in,out] x As input, vector `b`. As output, vector `x`.
+    /// @note Ensure method @ref decompose has been called before this method.
+    auto solve(VectorRef x) -> void;
+
+    /// Solve the linear systems `A*X = B` with multiple right-hand sides using the LDLT decomposition obtained with @ref decompose.
+    /// @note Ensure method @ref decompose has been called before this method.
+    auto solveMultiple(MatrixView B, MatrixRef X) -> void;
+
+    /// Solve the linear systems `A*X = B` with multiple right-hand sides using the LDLT decomposition obtained with @ref decompose.
+    /// @param[in,out] X As input, matrix `B`. As output, matrix `X`.
+    /// @note Ensure method @ref decompose has been called before this method.
+    auto solveMultiple(MatrixRef X) -> void;
+
+    /// Return the numbers of positive, negative, and zero eigenvalues of the last decomposed matrix (its inertia).
+    /// @note Ensure method @ref decompose has returned true before this method.
+    auto inertia() const -> std::array<Index, 3>;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
@@ -15,39 +15,70 @@
 // You should have received a copy of the GNU General Public License
 // along with this program. If not, see <http://www.gnu.org/licenses/>.
 
+
 #include "LU.hpp"
 
 // C++ includes
 #include <cassert>
-
-// Eigen includes
-#include <Eigen/src/LU/FullPivLU.h>
+#include <cmath>
 
 // Optima includes
 #include <Optima/Macros.hpp>
+#include <Optima/Utils.hpp>
 
 namespace Optima {
 
 struct LU::Impl
 {
     //======================================================================
-    // Note: The full pivoting strategy is needed at the moment to resolve
-    // singular matrices. Using a partial pivoting scheme via PartialPivLU
-    // would need to be combined with a search for linearly dependent rows in
-    // the produced upper triangular matrix U.
+    // Note: The full pivoting strategy is needed to resolve singular
+    // matrices, because it pushes the small pivots to the bottom of the
+    // diagonal of U, where they are detected when solving. However, it is
+    // unblocked and searches the entire remaining bottom-right corner at
+    // every step. The decomposition is thus first attempted with blocked
+    // partial pivoting, which is accepted if the estimated reciprocal
+    // condition number of the matrix is not small, in which case no
+    // equation would be discarded when solving anyway. Otherwise, the
+    // matrix is decomposed again with full pivoting. Since consecutive
+    // matrices in the iterations of the optimization calculation tend to be
+    // similar, full pivoting is used directly in the next decomposition if
+    // the last matrix was ill-conditioned.
+    //======================================================================
+
+    //======================================================================
+    // Note: The full-pivoting LU decomposition below follows the algorithm
+    // in Eigen::FullPivLU, but it is performed in the top-left corner of a
+    // workspace matrix whose dimensions never shrink. This avoids memory
+    // allocation when matrices of varying dimensions are decomposed in
+    // sequence, as in the iterations of the optimization calculation.
     //======================================================================
 
-    /// The base LU solver from Eigen library.
-    Eigen::FullPivLU<Matrix> lu;
+    /// The estimated reciprocal condition number below which full pivoting is used.
+    static constexpr double rcondmin = 1e-8;
+
+    /// The workspace whose top-left corner contains the lower and upper triangular factors of the last decomposed matrix.
+    Matrix LUw;
+
+    /// The row transpositions applied during the decomposition, which result in the permutation matrix P in P*A*Q = L*U.
+    Indices ptr;
+
+    /// The column transpositions applied during the decomposition, which result in the permutation matrix Q in P*A*Q = L*U.
+    Indices qtr;
 
-    /// The workspace for modified matrix U.
-    Matrix U;
+    /// The dimension of the last decomposed matrix.
+    Index n = 0;
 
     /// The flags that indicate if an equation is linearly independent (non-zero value).
     Indices is_li;
 
     /// The rank of the lineary system, not of the coefficient matrix (depends on right-hand side vector!)
-    Index rank;
+    Index rank = 0;
+
+    /// The flag that indicates if the last decomposed matrix needed full pivoting.
+    bool fullpivoting = false;
+
+    /// The workspace for the vectors used in the estimation of the reciprocal condition number.
+    Matrix rcondw;
 
     /// Construct a default Impl object.
     Impl()
@@ -62,16 +93,166 @@ struct LU::Impl
     /// Return true if empty.
     auto empty() const -> bool
     {
-        return lu.matrixLU().size() == 0;
+        return n == 0;
+    }
+
+    /// Allocate the workspace for the decomposition of matrices with dimension up to a given one.
+    auto reserve(Index m) -> void
+    {
+        ensureMinimumDimension(LUw, m, m);
+        ensureMinimumDimension(ptr, m);
+        ensureMinimumDimension(qtr, m);
+        ensureMinimumDimension(is_li, m);
+        ensureMinimumDimension(rcondw, m, 3);
     }
 
     /// Compute the LU decomposition of the given matrix.
     auto decompose(MatrixView A) -> void
     {
-        const auto m = A.rows();
-        const auto n = A.cols();
-        assert(n == m);
-        lu.compute(A);
+        assert(A.rows() == A.cols());
+
+        n = A.rows();
+
+        reserve(n);
+
+        if(n == 0)
+            return;
+
+        const auto Anorm = A.cwiseAbs().colwise().sum().maxCoeff();
+
+        if(!fullpivoting)
+        {
+            decomposePartialPivoting(A);
+            if(rcond(Anorm) >= rcondmin)
+                return;
+        }
+
+        decomposeFullPivoting(A);
+
+        fullpivoting = rcond(Anorm) < rcondmin;
+    }
+
+    /// Compute the LU decomposition of the given matrix using blocked partial pivoting.
+    auto decomposePartialPivoting(MatrixView A) -> void
+    {
+        using PartialPivLUImpl = Eigen::internal::partial_lu_impl<double, Eigen::ColMajor, Index>;
+
+        auto M = LUw.topLeftCorner(n, n);
+
+        M = A;
+
+        Index nswaps = 0;
+        PartialPivLUImpl::blocked_lu(n, n, M.data(), M.outerStride(), ptr.data(), nswaps);
+
+        for(Index k = 0; k < n; ++k)
+            qtr[k] = k;
+    }
+
+    /// Compute the LU decomposition of the given matrix using full pivoting.
+    auto decomposeFullPivoting(MatrixView A) -> void
+    {
+        auto M = LUw.topLeftCorner(n, n);
+
+        M = A;
+
+        for(Index k = 0; k < n; ++k)
+        {
+            // Find the entry with maximum absolute value in the remaining bottom-right corner
+            Index i, j;
+            const double biggest = M.bottomRightCorner(n - k, n - k).cwiseAbs().maxCoeff(&i, &j);
+
+            // Stop if the remaining corner is zero, leaving its rows and columns in place
+            if(biggest == 0.0)
+            {
+                for(Index l = k; l < n; ++l)
+                    ptr[l] = qtr[l] = l;
+                break;
+            }
+
+            i += k;
+            j += k;
+
+            // Bring the pivot to position (k, k)
+            ptr[k] = i;
+            qtr[k] = j;
+
+            if(k != i) M.row(k).swap(M.row(i));
+            if(k != j) M.col(k).swap(M.col(j));
+
+            // Update the remaining bottom-right corner with Gaussian elimination
+            if(k < n - 1)
+            {
+                M.col(k).tail(n - k - 1) /= M(k, k);
+                M.bottomRightCorner(n - k - 1, n - k - 1).noalias() -= M.col(k).tail(n - k - 1) * M.row(k).tail(n - k - 1);
+            }
+        }
+    }
+
+    /// Return an estimate of the reciprocal condition number of the last decomposed matrix in the 1-norm.
+    /// This uses Hager's method to estimate the 1-norm of the inverse matrix from a few solves with the LU factors.
+    /// @param Anorm The 1-norm of the last decomposed matrix.
+    auto rcond(double Anorm) -> double
+    {
+        const auto M = LUw.topLeftCorner(n, n);
+
+        if(Anorm == 0.0 || (M.diagonal().array() == 0.0).any())
+            return 0.0;
+
+        auto x = rcondw.col(0).head(n);
+        auto y = rcondw.col(1).head(n);
+        auto z = rcondw.col(2).head(n);
+
+        x.fill(1.0 / n);
+
+        double Ainvnorm = 0.0;
+
+        for(auto iter = 0; iter < 5; ++iter)
+        {
+            y = x;
+            solveA(y);
+            Ainvnorm = y.lpNorm<1>();
+
+            for(Index i = 0; i < n; ++i)
+                z[i] = y[i] >= 0.0 ? 1.0 : -1.0;
+            solveAt(z);
+
+            Index j;
+            const auto zmax = z.cwiseAbs().maxCoeff(&j);
+
+            if(zmax <= z.dot(x))
+                break;
+
+            x.fill(0.0);
+            x[j] = 1.0;
+        }
+
+        const auto res = 1.0 / (Anorm * Ainvnorm);
+
+        return std::isfinite(res) ? res : 0.0;
+    }
+
+    /// Solve the linear system `A*x = b` in-place with the LU factors, without discarding any equation.
+    template<typename VectorType>
+    auto solveA(VectorType&& x) const -> void
+    {
+        const auto M = LUw.topLeftCorner(n, n);
+        applyP(x);
+        M.triangularView<Eigen::UnitLower>().solveInPlace(x);
+        M.triangularView<Eigen::Upper>().solveInPlace(x);
+        applyQ(x);
+    }
+
+    /// Solve the linear system `tr(A)*x = b` in-place with the LU factors, without discarding any equation.
+    template<typename VectorType>
+    auto solveAt(VectorType&& x) const -> void
+    {
+        const auto M = LUw.topLeftCorner(n, n);
+        for(Index k = 0; k < n; ++k)
+            std::swap(x[k], x[qtr[k]]);
+        M.transpose().triangularView<Eigen::Lower>().solveInPlace(x);
+        M.transpose().triangularView<Eigen::UnitUpper>().solveInPlace(x);
+        for(Index k = n - 1; k >= 0; --k)
+            std::swap(x[k], x[ptr[k]]);
     }
 
     /// Solve the linear system `Ax = b` using the LU decomposition obtained with @ref decompose.
@@ -84,61 +265,151 @@ struct LU::Impl
     /// Solve the linear system `Ax = b` using the LU decomposition obtained with @ref decompose.
     auto solve(VectorRef x) -> void
     {
-        const auto& n  = lu.rows();
-        const auto& P  = lu.permutationP();
-        const auto& Q  = lu.permutationQ();
-        const auto& M  = lu.matrixLU();
-        const auto& Lv = M.triangularView<Eigen::UnitLower>();
-        const auto& Uv = U.triangularView<Eigen::Upper>();
-
         assert(n == x.rows());
 
-        P.applyThisOnTheLeft(x);
-        x = Lv.solve(x);
-        assembleU(x);
-        x = Uv.solve(x);
-        Q.applyThisOnTheLeft(x);
-        Q.applyThisOnTheLeft(is_li);
+        const auto M = LUw.topLeftCorner(n, n);
+
+        applyP(x);
+        M.triangularView<Eigen::UnitLower>().solveInPlace(x);
+        if(findDependentEquations(x))
+            solveUpperDiscarding(x);
+        else M.triangularView<Eigen::Upper>().solveInPlace(x);
+        applyQ(x);
+        applyQ(is_li.head(n));
 
         // TODO; In LU, x should have +inf or -inf to indicate extremely large steps and their directions. Then a line search would be used to find a reasonable step length/
     }
 
-    /// Assemble the U matrix with given y, where y is the solution of L*y = P*b.
-    auto assembleU(VectorRef y) -> void
+    /// Solve the linear systems `AX = B` using the LU decomposition obtained with @ref decompose.
+    auto solveMultiple(MatrixRef X) -> void
+    {
+        assert(n == X.rows());
+
+        if(X.cols() == 0)
+            return;
+
+        if(X.cols() == 1)
+            return solve(X.col(0));
+
+        const auto M = LUw.topLeftCorner(n, n);
+
+        for(Index k = 0; k < n; ++k)
+            if(ptr[k] != k) X.row(k).swap(X.row(ptr[k]));
+
+        M.triangularView<Eigen::UnitLower>().solveInPlace(X);
+
+        // Check if any equation would be discarded for some right-hand
+        // side. If so, the discarded equations may differ among the columns
+        // of X, and the remaining solution steps are performed column by
+        // column. Otherwise, all columns are solved at once.
+        const auto D = M.diagonal().cwiseAbs();
+        const auto eps = std::numeric_limits<double>::epsilon();
+
+        auto discarding = false;
+        for(Index i = 0; i < n && !discarding; ++i)
+            discarding = D[i] <= eps * X.row(i).cwiseAbs().maxCoeff();
+
+        if(discarding)
+        {
+            for(Index j = 0; j < X.cols(); ++j)
+            {
+                auto x = X.col(j);
+                if(findDependentEquations(x))
+                    solveUpperDiscarding(x);
+                else M.triangularView<Eigen::Upper>().solveInPlace(x);
+                applyQ(x);
+            }
+            applyQ(is_li.head(n));
+            return;
+        }
+
+        M.triangularView<Eigen::Upper>().solveInPlace(X);
+
+        for(Index k = n - 1; k >= 0; --k)
+            if(qtr[k] != k) X.row(k).swap(X.row(qtr[k]));
+
+        is_li.head(n).setOnes();
+        rank = n;
+    }
+
+    /// Apply the permutation matrix P on the given vector in-place.
+    template<typename VectorType>
+    auto applyP(VectorType&& x) const -> void
     {
-        const auto n = lu.rows();
+        for(Index k = 0; k < n; ++k)
+            std::swap(x[k], x[ptr[k]]);
+    }
+
+    /// Apply the permutation matrix Q on the given vector in-place.
+    template<typename VectorType>
+    auto applyQ(VectorType&& x) const -> void
+    {
+        for(Index k = n - 1; k >= 0; --k)
+            std::swap(x[k], x[qtr[k]]);
+    }
 
-        U.resize(n, n);
-        U = lu.matrixLU();
+    /// Return the permutation matrix P in P*A*Q = L*U.
+    auto P() const -> PermutationMatrix
+    {
+        PermutationMatrix res;
+        res.setIdentity(n);
+        for(Index k = n - 1; k >= 0; --k)
+            res.applyTranspositionOnTheRight(k, ptr[k]);
+        return res;
+    }
 
-        is_li.setOnes(n); // set all equations as linearly independent to start with
+    /// Return the permutation matrix Q in P*A*Q = L*U.
+    auto Q() const -> PermutationMatrix
+    {
+        PermutationMatrix res;
+        res.setIdentity(n);
+        for(Index k = 0; k < n; ++k)
+            res.applyTranspositionOnTheRight(k, qtr[k]);
+        return res;
+    }
 
-        const auto D = U.diagonal().cwiseAbs();
+    /// Determine the equations in `U*x = y` that are discarded, where y is the solution of `L*y = P*b`.
+    /// @return True if any equation is discarded.
+    auto findDependentEquations(VectorView y) -> bool
+    {
+        const auto D = LUw.topLeftCorner(n, n).diagonal().cwiseAbs();
         const auto eps = std::numeric_limits<double>::epsilon();
 
-        using std::max;
         using std::abs;
 
-        rank = n; // start full rank, decrease as we go along through the diagonal of U (from the bottom!)
-        for(auto i = 1; i <= n; ++i)
+        // Check diagonal entry is not very small compared to the
+        // corresponding entry in y. The idea is that if a diagonal entry is
+        // very small, but the corresponding entry in y is equally small,
+        // then it is safe not to discard this linear equation. Otherwise, we
+        // discard it, to avoid extremely large values when we divide a
+        // larger number by the diagonal pivot (very small).
+        rank = n;
+        for(Index i = 0; i < n; ++i)
+        {
+            is_li[i] = D[i] > eps * abs(y[i]);
+            rank -= 1 - is_li[i];
+        }
+
+        return rank < n;
+    }
+
+    /// Solve `U*x = y` in-place with the equations determined in @ref findDependentEquations discarded.
+    /// This is equivalent to zeroing the off-diagonal entries along the row
+    /// and column of U of each discarded equation, setting its diagonal
+    /// entry to one and the corresponding entry in y to zero, without
+    /// modifying a copy of U.
+    auto solveUpperDiscarding(VectorRef x) const -> void
+    {
+        const auto M = LUw.topLeftCorner(n, n);
+
+        for(Index i = n - 1; i >= 0; --i)
         {
-            // Check diagonal entry is not very small compared to other entries
-            // on same row of U and also right-hand side entry in y. The idea
-            // is that if a diagonal entry is very small, but the other
-            // coefficients along the same row of U is also very small and the
-            // corresponding entry in y is equally small, then it is safe not
-            // to discard this linear equation. Otherwise, we discard it, to
-            // avoid extremely large values when we divide a larger number by
-            // the diagonal pivot (very small).
-            if(D[n - i] <= eps * abs(y[n - i]))
+            if(is_li[i])
             {
-                U.row(n - i).tail(n - i).fill(0.0); // avoid going to the lower triangular part
-                U.col(n - i).head(n - i).fill(0.0);
-                U(n - i, n - i) = 1.0; // diagonal entry is 1 while the rest entries along the same row/col are 0
-                y[n - i] = 0.0; // the solution of the corresponding unknown should be zero
-                is_li[n - i] = 0; // equation not linearly independent
-                --rank;
+                x[i] /= M(i, i);
+                x.head(i) -= x[i] * M.col(i).head(i);
             }
+            else x[i] = 0.0; // the solution of the corresponding unknown should be zero
         }
     }
 };
@@ -165,6 +436,11 @@ auto LU::empty() const -> bool
     return pimpl->empty();
 }
 
+auto LU::reserve(Index n) -> void
+{
+    pimpl->reserve(n);
+}
+
 auto LU::decompose(MatrixView A) -> void
 {
     pimpl->decompose(A);
@@ -181,6 +457,17 @@ auto LU::solve(VectorRef x) -> void
     pimpl->solve(x);
 }
 
+auto LU::solveMultiple(MatrixView B, MatrixRef X) -> void
+{
+    X = B;
+    pimpl->solveMultiple(X);
+}
+
+auto LU::solveMultiple(MatrixRef X) -> void
+{
+    pimpl->solveMultiple(X);
+}
+
 auto LU::rank() const -> Index
 {
     return pimpl->rank;
@@ -188,17 +475,17 @@ auto LU::rank() const -> Index
 
 auto LU::matrixLU() const -> MatrixView
 {
-    return pimpl->lu.matrixLU();
+    return pimpl->LUw.topLeftCorner(pimpl->n, pimpl->n);
 }
 
 auto LU::P() const -> PermutationMatrix
 {
-    return pimpl->lu.permutationP();
+    return pimpl->P();
 }
 
 auto LU::Q() const -> PermutationMatrix
 {
-    return pimpl->lu.permutationP();
+    return pimpl->Q();
 }
 
 } // namespace Optima
@@ -44,6 +44,11 @@ struct LU
     /// Return true if empty.
     auto empty() const -> bool;
 
+    /// Allocate the workspace for the decomposition of matrices with dimension up to a given one.
+    /// Use this method to avoid heap allocations when matrices of varying
+    /// dimensions are decomposed in sequence (see HeapAllocationGuard).
+    auto reserve(Index n) -> void;
+
     /// Compute the LU decomposition of the given matrix.
     auto decompose(MatrixView A) -> void;
 
@@ -56,6 +61,15 @@ struct LU
     /// @note Ensure method @ref decompose has been called before this method.
     auto solve(VectorRef x) -> void;
 
+    /// Solve the linear systems `A*X = B` with multiple right-hand sides using the LU decomposition obtained with @ref decompose.
+    /// @note Ensure method @ref decompose has been called before this method.
+    auto solveMultiple(MatrixView B, MatrixRef X) -> void;
+
+    /// Solve the linear systems `A*X = B` with multiple right-hand sides using the LU decomposition obtained with @ref decompose.
+    /// @param[in,out] X As input, matrix `B`. As output, matrix `X`.
+    /// @note Ensure method @ref decompose has been called before this method.
+    auto solveMultiple(MatrixRef X) -> void;
+
     /// Return the rank of the last LU decomposed matrix.
     /// @note Ensure method @ref decompose or @ref solveWithScaling has been called before this method.
     auto rank() const -> Index;
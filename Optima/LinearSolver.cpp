@@ -17,11 +17,20 @@
 
 #include "LinearSolver.hpp"
 
+// C++ includes
+#include <algorithm>
+#include <array>
+#include <cmath>
+
 // Optima includes
 #include <Optima/Exception.hpp>
 #include <Optima/LinearSolverFullspace.hpp>
+#include <Optima/LinearSolverIterative.hpp>
 #include <Optima/LinearSolverNullspace.hpp>
 #include <Optima/LinearSolverRangespace.hpp>
+#include <Optima/LinearSolverSparse.hpp>
+#include <Optima/Timing.hpp>
+#include <Optima/Utils.hpp>
 
 namespace Optima {
 
@@ -32,40 +41,328 @@ struct LinearSolver::Impl
     LinearSolverRangespace rangespace; ///< The linear solver based on a rangespace algorithm.
     LinearSolverNullspace nullspace;   ///< The linear solver based on a nullspace algorithm.
     LinearSolverFullspace fullspace;   ///< The linear solver based on a fullspace algorithm.
+    LinearSolverSparse sparse;         ///< The linear solver based on a sparse LU decomposition.
+    LinearSolverIterative iterative;   ///< The linear solver based on a matrix-free Krylov method.
+
+    Matrix x; ///< The auxiliary solution vectors x.
+    Matrix p; ///< The auxiliary solution vectors p.
+    Matrix w; ///< The auxiliary solution vectors w.
+
+    Matrix wbar; ///< The auxiliary solution vectors w' = (w'bs, w'bu, w'bl).
+
+    Matrix ax; ///< The auxiliary solution vectors ax.
+    Matrix aw; ///< The auxiliary solution vectors aw.
+
+    Matrix res; ///< The workspace for the residual vectors of the canonical master system in method Automatic.
+
+    LinearSolverMethod method = LinearSolverMethod::Nullspace; ///< The method used in the last decomposition.
+
+    std::array<double, 3> rates = {};  ///< The measured wall time per estimated operation in the decompositions with methods Fullspace, Nullspace, Rangespace (zero if not measured).
+    std::array<bool, 3> failed = {};   ///< The flags indicating the methods among Fullspace, Nullspace, Rangespace that produced inaccurate solutions with the last decomposed canonical master matrix in method Automatic.
 
-    Vector x; ///< The auxiliary solution vector x.
-    Vector p; ///< The auxiliary solution vector p.
-    Vector w; ///< The auxiliary solution vector w.
+    std::array<Index, 3> prepared = { -1, -1, -1 }; ///< The dimensions (nx, np, nw) for which the workspaces of all methods in method Automatic have been allocated.
 
-    Vector wbar; ///< The auxiliary solution vector w' = (w'bs, w'bu, w'bl).
+    bool previous = false; ///< True if the current solution is computed on purpose with the decomposition of a previous canonical master matrix.
 
-    Vector ax; ///< The auxiliary solution vector ax.
-    Vector aw; ///< The auxiliary solution vector aw.
+    /// The largest relative backward error of an accepted solution in method Automatic.
+    static constexpr double maxerror = 1e-8;
+
+    //======================================================================
+    // Note: In method Automatic, the solution of the canonical master system
+    // is accepted only if its relative backward error,
+    //
+    //   norminf(a - M*u) / (norminf(M)*norminf(u) + norminf(a)),
+    //
+    // does not exceed maxerror, where norminf(M) is estimated from above with
+    // the sum of the infinity norms of the blocks of M. Otherwise (e.g., the
+    // matrix reduced by the selected method is rank-deficient or too
+    // ill-conditioned, and its solution is finite but wrong), the canonical
+    // master matrix is decomposed and solved again with the next best method.
+    // The failed methods are excluded only until the next decomposition.
+    // The solutions computed on purpose with the decomposition of a previous
+    // canonical master matrix (e.g., in the simplified Newton method) are
+    // not checked, since they are not expected to be accurate.
+    // Because any of the methods can be needed in an iteration, all of them
+    // are used once in the first solve after the dimensions of the problem
+    // change, so that their workspaces are allocated before the iterations
+    // in which heap allocation is not allowed (see HeapAllocationGuard).
+    //======================================================================
 
     Impl()
     {}
 
-    auto solveCanonical(CanonicalMatrix Mc, CanonicalVectorView ac, CanonicalVectorRef uc) -> void
+    auto setOptions(const LinearSolverOptions& opts) -> void
+    {
+        options = opts;
+        nullspace.setOptions(opts);
+        fullspace.setOptions(opts);
+        iterative.setOptions(opts);
+        rates = {};
+        failed = {};
+        prepared = { -1, -1, -1 };
+    }
+
+    /// Return the estimated number of floating-point operations in the decomposition of the canonical master matrix with given method.
+    static auto cost(LinearSolverMethod method, const CanonicalDims& dims) -> double
     {
-        switch(options.method)
+        const double ns  = dims.ns;
+        const double np  = dims.np;
+        const double nbs = dims.nbs;
+        const double nns = dims.nns;
+        const double nbe = dims.nbe;
+        const double nbi = dims.nbi;
+        const double nne = dims.nne;
+        const double nni = dims.nni;
+
+        const auto lu = [](double t) { return 2.0/3.0 * t*t*t + 2.0 * t*t; }; // the cost of the LU decomposition of a t-by-t matrix and the solution with it
+
+        switch(method)
         {
-        case LinearSolverMethod::Nullspace: nullspace.solve(Mc, ac, uc); break;
-        case LinearSolverMethod::Rangespace: rangespace.solve(Mc, ac, uc); break;
-        default: fullspace.solve(Mc, ac, uc); break;
+        case LinearSolverMethod::Nullspace: return 1.0 + lu(nbe + nns + np + nbe) + 2.0 * nbi * (nbs + 2*nns + np) * (nns + np);
+        case LinearSolverMethod::Rangespace: return 1.0 + lu(np + nbi + nbe + nni) + 2.0 * nbs * nbs * nne;
+        default: return 1.0 + lu(ns + np + nbs);
         }
     }
 
-    auto decompose(CanonicalMatrix Mc) -> void
+    /// Return true if given method can be used for the decomposition of the canonical master matrix in method Automatic.
+    auto eligible(LinearSolverMethod method, CanonicalMatrix Mc) const -> bool
     {
-        switch(options.method)
+        if(failed[static_cast<Index>(method)])
+            return false;
+        if(method == LinearSolverMethod::Rangespace)
+            return Mc.isHssDiag;
+        return true;
+    }
+
+    /// Return the method with least estimated cost for the decomposition of the canonical master matrix.
+    auto select(CanonicalMatrix Mc) const -> LinearSolverMethod
+    {
+        const auto methods = { LinearSolverMethod::Fullspace, LinearSolverMethod::Nullspace, LinearSolverMethod::Rangespace };
+
+        // The rate for the methods not yet measured is taken as the least measured one
+        auto reference = 0.0;
+        for(auto m : methods)
+        {
+            const auto rate = rates[static_cast<Index>(m)];
+            if(eligible(m, Mc) && rate > 0.0)
+                reference = reference > 0.0 ? std::min(reference, rate) : rate;
+        }
+        if(reference == 0.0)
+            reference = 1.0;
+
+        auto selected = LinearSolverMethod::Fullspace; // if all methods have failed, this is also a failed method
+        auto least = infinity();
+        for(auto m : methods)
+        {
+            if(!eligible(m, Mc)) continue;
+            const auto rate = rates[static_cast<Index>(m)];
+            const auto estimate = cost(m, Mc.dims) * (rate > 0.0 ? rate : reference);
+            if(estimate < least)
+            {
+                least = estimate;
+                selected = m;
+            }
+        }
+
+        // Measure first the methods whose estimated cost is close to the least one
+        if(options.calibrate)
+            for(auto m : methods)
+                if(eligible(m, Mc) && rates[static_cast<Index>(m)] == 0.0 && cost(m, Mc.dims) * reference <= 4.0 * least)
+                    return m;
+
+        return selected;
+    }
+
+    auto decomposeWith(LinearSolverMethod m, CanonicalMatrix Mc) -> void
+    {
+        switch(m)
         {
         case LinearSolverMethod::Nullspace: nullspace.decompose(Mc); break;
         case LinearSolverMethod::Rangespace: rangespace.decompose(Mc); break;
+        case LinearSolverMethod::Sparse: sparse.decompose(Mc); break;
+        case LinearSolverMethod::Iterative: iterative.decompose(Mc); break;
         default: fullspace.decompose(Mc); break;
         }
     }
 
+    auto solveWith(LinearSolverMethod m, CanonicalMatrix Mc, CanonicalVectorsView ac, CanonicalVectorsRef uc) -> void
+    {
+        switch(m)
+        {
+        case LinearSolverMethod::Nullspace: nullspace.solveMultiple(Mc, ac, uc); break;
+        case LinearSolverMethod::Rangespace: rangespace.solveMultiple(Mc, ac, uc); break;
+        case LinearSolverMethod::Sparse: sparse.solveMultiple(Mc, ac, uc); break;
+        case LinearSolverMethod::Iterative: iterative.solveMultiple(Mc, ac, uc); break;
+        default: fullspace.solveMultiple(Mc, ac, uc); break;
+        }
+    }
+
+    /// Return the largest relative backward error among the solutions of the canonical master system.
+    auto backwardError(CanonicalMatrix Mc, CanonicalVectorsView ac, CanonicalVectorsView uc) -> double
+    {
+        const auto dims = Mc.dims;
+
+        const auto ns  = dims.ns;
+        const auto np  = dims.np;
+        const auto nbs = dims.nbs;
+        const auto nns = dims.nns;
+
+        const auto t = ns + np + nbs;
+        const auto k = ac.xs.cols();
+
+        if(t == 0 || k == 0)
+            return 0.0;
+
+        const auto norminf = [](auto A) { return A.size() ? A.cwiseAbs().rowwise().sum().maxCoeff() : 0.0; };
+        const auto normvec = [](auto v) { return v.size() ? v.cwiseAbs().maxCoeff() : 0.0; };
+
+        const auto Hss   = Mc.Hss;
+        const auto Hsp   = Mc.Hsp;
+        const auto Vps   = Mc.Vps;
+        const auto Vpp   = Mc.Vpp;
+        const auto Sbsns = Mc.Sbsns;
+        const auto Sbsp  = Mc.Sbsp;
+
+        const auto xs  = uc.xs;
+        const auto xbs = xs.topRows(nbs);
+        const auto xns = xs.bottomRows(nns);
+        const auto p   = uc.p;
+        const auto wbs = uc.wbs;
+
+        ensureMinimumDimension(res, t, k);
+
+        auto r   = res.topLeftCorner(t, k);
+        auto rs  = r.topRows(ns);
+        auto rp  = r.middleRows(ns, np);
+        auto rbs = r.bottomRows(nbs);
+
+        rs = ac.xs;
+        if(Mc.isHssDiag)
+            rs -= Hss.diagonal().asDiagonal() * xs;
+        else rs.noalias() -= Hss * xs;
+        rs.noalias() -= Hsp * p;
+        rs.topRows(nbs) -= wbs;
+        rs.bottomRows(nns).noalias() -= tr(Sbsns) * wbs;
+
+        rp = ac.p;
+        rp.noalias() -= Vps * xs;
+        rp.noalias() -= Vpp * p;
+
+        rbs = ac.wbs;
+        rbs -= xbs;
+        rbs.noalias() -= Sbsns * xns;
+        rbs.noalias() -= Sbsp * p;
+
+        const auto Hnorm = Mc.isHssDiag ? normvec(Hss.diagonal()) : norminf(Hss);
+        const auto Mnorm = 1.0 + Hnorm + norminf(Hsp) + norminf(Vps) + norminf(Vpp) + norminf(Sbsns) + norminf(tr(Sbsns)) + norminf(Sbsp);
+
+        auto error = 0.0;
+        for(Index j = 0; j < k; ++j)
+        {
+            const auto rnorm = normvec(r.col(j));
+            if(rnorm == 0.0)
+                continue;
+            const auto unorm = std::max({ normvec(xs.col(j)), normvec(p.col(j)), normvec(wbs.col(j)) });
+            const auto anorm = std::max({ normvec(ac.xs.col(j)), normvec(ac.p.col(j)), normvec(ac.wbs.col(j)) });
+            const auto current = rnorm / (Mnorm * unorm + anorm);
+            if(!(current <= error))
+                error = current; // also propagates NaN
+            if(std::isnan(error))
+                break;
+        }
+
+        return error;
+    }
+
+    /// Allocate the workspaces of all methods that can be selected in method Automatic, if not yet for the dimensions of the canonical master matrix.
+    auto prepare(CanonicalMatrix Mc, CanonicalVectorsView ac, CanonicalVectorsRef uc) -> void
+    {
+        const std::array<Index, 3> current = { Mc.dims.nx, Mc.dims.np, Mc.dims.nw };
+
+        if(prepared == current)
+            return;
+
+        for(auto m : { LinearSolverMethod::Fullspace, LinearSolverMethod::Nullspace, LinearSolverMethod::Rangespace })
+        {
+            if(m == method || (m == LinearSolverMethod::Rangespace && !Mc.isHssDiag))
+                continue;
+            decomposeWith(m, Mc);
+            solveWith(m, Mc, ac, uc);
+        }
+
+        prepared = current;
+    }
+
+    auto solveCanonical(CanonicalMatrix Mc, CanonicalVectorsView ac, CanonicalVectorsRef uc) -> void
+    {
+        if(options.method == LinearSolverMethod::Automatic)
+            prepare(Mc, ac, uc);
+
+        solveWith(method, Mc, ac, uc);
+
+        if(options.method != LinearSolverMethod::Automatic || previous)
+            return;
+
+        // Decompose and solve again with the next best method if the solution is not accurate
+        while(!(backwardError(Mc, ac, uc) <= maxerror))
+        {
+            failed[static_cast<Index>(method)] = true;
+            const auto fallback = select(Mc);
+            if(failed[static_cast<Index>(fallback)])
+                break; // all methods have failed
+            decompose(fallback, Mc);
+            solveWith(method, Mc, ac, uc);
+        }
+    }
+
+    auto decompose(LinearSolverMethod m, CanonicalMatrix Mc) -> void
+    {
+        method = m;
+
+        if(!(options.method == LinearSolverMethod::Automatic && options.calibrate))
+            return decomposeWith(method, Mc);
+
+        const Timer timer;
+        decomposeWith(method, Mc);
+        const auto rate = timer.elapsed() / cost(method, Mc.dims);
+
+        auto& current = rates[static_cast<Index>(method)];
+        current = current > 0.0 ? 0.5 * (current + rate) : rate;
+    }
+
+    auto decompose(CanonicalMatrix Mc) -> void
+    {
+        if(options.method != LinearSolverMethod::Automatic)
+            return decompose(options.method, Mc);
+        failed = {};
+        decompose(select(Mc), Mc);
+    }
+
     auto solve(CanonicalMatrix Mc, MasterVectorView a, MasterVectorRef u) -> void
+    {
+        solveMultiple(Mc, a, u);
+    }
+
+    auto solve(CanonicalMatrix Mc, CanonicalVectorView a, MasterVectorRef u) -> void
+    {
+        solveMultiple(Mc, a, u);
+    }
+
+    auto solveWithPreviousDecomposition(CanonicalMatrix Mc, MasterVectorView a, MasterVectorRef u) -> void
+    {
+        previous = true;
+        solveMultiple(Mc, a, u);
+        previous = false;
+    }
+
+    auto solveWithPreviousDecomposition(CanonicalMatrix Mc, CanonicalVectorView a, MasterVectorRef u) -> void
+    {
+        previous = true;
+        solveMultiple(Mc, a, u);
+        previous = false;
+    }
+
+    auto solveMultiple(CanonicalMatrix Mc, MasterVectorsView a, MasterVectorsRef u) -> void
     {
         const auto dims = Mc.dims;
         const auto Rbs  = Mc.Rbs;
@@ -77,23 +374,25 @@ struct LinearSolver::Impl
         const auto nbs = dims.nbs;
         const auto nns = dims.nns;
 
-        ax.resize(dims.nx);
-        auto as = ax.head(ns);
-        auto au = ax.tail(nu);
+        const auto k = a.x.cols();
 
-        as.noalias() = a.x(js);
-        au.noalias() = a.x(ju);
+        ax.resize(dims.nx, k);
+        auto as = ax.topRows(ns);
+        auto au = ax.bottomRows(nu);
 
-        aw.resize(dims.nw);
-        auto awbs = aw.head(nbs);
-        awbs = Rbs * a.w;
+        as.noalias() = a.x(js, Eigen::all);
+        au.noalias() = a.x(ju, Eigen::all);
+
+        aw.resize(dims.nw, k);
+        auto awbs = aw.topRows(nbs);
+        awbs.noalias() = Rbs * a.w;
 
         const auto ap = a.p;
 
-        solve(Mc, {as, au, ap, awbs}, u);
+        solveMultiple(Mc, CanonicalVectorsView{as, au, ap, awbs}, u);
     }
 
-    auto solve(CanonicalMatrix Mc, CanonicalVectorView a, MasterVectorRef u) -> void
+    auto solveMultiple(CanonicalMatrix Mc, CanonicalVectorsView a, MasterVectorsRef u) -> void
     {
         const auto dims = Mc.dims;
         const auto Rbs  = Mc.Rbs;
@@ -105,25 +404,28 @@ struct LinearSolver::Impl
         const auto nbs = dims.nbs;
         const auto nl  = dims.nl;
 
-        p.resize(dims.np);
-        x.resize(dims.nx);
-        auto xs = x.head(ns);
-        auto xu = x.tail(nu);
+        const auto k = a.xs.cols();
+
+        p.resize(dims.np, k);
+        x.resize(dims.nx, k);
+        auto xs = x.topRows(ns);
+        auto xu = x.bottomRows(nu);
 
-        wbar.resize(dims.nw);
-        auto wbs = wbar.head(nbs);
+        wbar.resize(dims.nw, k);
+        auto wbs = wbar.topRows(nbs);
 
         const auto as = a.xs;
         const auto au = a.xu;
         const auto ap = a.p;
-        const auto awbs = a.wbs.head(nbs);
+        const auto awbs = a.wbs.topRows(nbs);
 
-        solveCanonical(Mc, {as, au, ap, awbs}, {xs, xu, p, wbs});
+        solveCanonical(Mc, CanonicalVectorsView{as, au, ap, awbs}, CanonicalVectorsRef{xs, xu, p, wbs});
 
+        w.resize(dims.nw, k);
         w.noalias() = tr(Rbs) * wbs;
 
-        u.x(js) = xs;
-        u.x(ju) = au;
+        u.x(js, Eigen::all) = xs;
+        u.x(ju, Eigen::all) = au;
         u.p = p;
         u.w = w;
     }
@@ -148,7 +450,7 @@ auto LinearSolver::operator=(LinearSolver other) -> LinearSolver&
 
 auto LinearSolver::setOptions(const LinearSolverOptions& options) -> void
 {
-    pimpl->options = options;
+    pimpl->setOptions(options);
 }
 
 auto LinearSolver::options() const -> const LinearSolverOptions&
@@ -171,4 +473,24 @@ auto LinearSolver::solve(CanonicalMatrix Mc, CanonicalVectorView ac, MasterVecto
     pimpl->solve(Mc, ac, u);
 }
 
+auto LinearSolver::solveWithPreviousDecomposition(CanonicalMatrix Mc, MasterVectorView a, MasterVectorRef u) -> void
+{
+    pimpl->solveWithPreviousDecomposition(Mc, a, u);
+}
+
+auto LinearSolver::solveWithPreviousDecomposition(CanonicalMatrix Mc, CanonicalVectorView ac, MasterVectorRef u) -> void
+{
+    pimpl->solveWithPreviousDecomposition(Mc, ac, u);
+}
+
+auto LinearSolver::solveMultiple(CanonicalMatrix Mc, MasterVectorsView a, MasterVectorsRef u) -> void
+{
+    pimpl->solveMultiple(Mc, a, u);
+}
+
+auto LinearSolver::solveMultiple(CanonicalMatrix Mc, CanonicalVectorsView ac, MasterVectorsRef u) -> void
+{
+    pimpl->solveMultiple(Mc, ac, u);
+}
+
 } // namespace Optima
@@ -72,6 +72,45 @@ public:
     /// @param[out] u The solution master vector in the linear problem.
     auto solve(CanonicalMatrix Mc, CanonicalVectorView ac, MasterVectorRef u) -> void;
 
+    /// Solve the linear problem with the decomposition of a previous canonical master matrix.
+    /// This method is used when the last decomposition is deliberately reused
+    /// for a slightly different canonical master matrix with the same basic
+    /// and stable variables (e.g., in the simplified Newton method), so that
+    /// the solution is only approximate. Its accuracy is thus not checked in
+    /// method Automatic, which would otherwise decompose the matrix again
+    /// with another method.
+    /// @param Mc The canonical form of the master matrix in the linear problem.
+    /// @param a The right-hand side master vector in the linear problem.
+    /// @param[out] u The solution master vector in the linear problem.
+    auto solveWithPreviousDecomposition(CanonicalMatrix Mc, MasterVectorView a, MasterVectorRef u) -> void;
+
+    /// Solve the linear problem with the decomposition of a previous canonical master matrix.
+    /// @param Mc The canonical form of the master matrix in the linear problem.
+    /// @param ac The right-hand side vector in the linear problem already in its canonical form.
+    /// @param[out] u The solution master vector in the linear problem.
+    /// @see solveWithPreviousDecomposition(CanonicalMatrix, MasterVectorView, MasterVectorRef)
+    auto solveWithPreviousDecomposition(CanonicalMatrix Mc, CanonicalVectorView ac, MasterVectorRef u) -> void;
+
+    /// Solve the linear problem for multiple right-hand side vectors.
+    /// Using this method presumes method @ref decompose has already been
+    /// called. The columns in the members of `a` and `u` are the right-hand
+    /// side vectors and the corresponding solution vectors, which are
+    /// computed together with matrix-matrix operations.
+    /// @param Mc The canonical form of the master matrix in the linear problem.
+    /// @param a The right-hand side master vectors in the linear problem.
+    /// @param[out] u The solution master vectors in the linear problem.
+    auto solveMultiple(CanonicalMatrix Mc, MasterVectorsView a, MasterVectorsRef u) -> void;
+
+    /// Solve the linear problem for multiple right-hand side vectors.
+    /// Using this method presumes method @ref decompose has already been
+    /// called. The columns in the members of `ac` and `u` are the right-hand
+    /// side vectors and the corresponding solution vectors, which are
+    /// computed together with matrix-matrix operations.
+    /// @param Mc The canonical form of the master matrix in the linear problem.
+    /// @param ac The right-hand side vectors in the linear problem already in their canonical form.
+    /// @param[out] u The solution master vectors in the linear problem.
+    auto solveMultiple(CanonicalMatrix Mc, CanonicalVectorsView ac, MasterVectorsRef u) -> void;
+
 private:
     struct Impl;
 
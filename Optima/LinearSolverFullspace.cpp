@@ -24,15 +24,40 @@
 #include <Optima/CanonicalVector.hpp>
 #include <Optima/CanonicalMatrix.hpp>
 #include <Optima/Exception.hpp>
+#include <Optima/LDLT.hpp>
 #include <Optima/LU.hpp>
+#include <Optima/MixedPrecisionLU.hpp>
+#include <Optima/Utils.hpp>
 
 namespace Optima {
 
 struct LinearSolverFullspace::Impl
 {
     Matrix mat; ///< The matrix used as a workspace for the decompose and solve methods.
-    Vector vec; ///< The vector used as a workspace for the decompose and solve methods
+    Matrix rhs; ///< The matrix used as a workspace for the right-hand side vectors in the solve methods.
     LU lu;      ///< The LU decomposition solver.
+    LDLT ldlt;  ///< The LDLT decomposition solver for symmetric matrices.
+    MixedPrecisionLU mlu; ///< The single-precision LU decomposition solver with iterative refinement.
+    bool symmetric = false; ///< The boolean flag that indicates whether the last decomposed matrix was symmetric and decomposed with LDLT.
+    bool mixed = false;     ///< The boolean flag that indicates whether the last decomposed matrix was decomposed in single precision.
+
+    LinearSolverOptions options; ///< The options for the linear solver.
+
+    //======================================================================
+    // Note: The assembled matrix is symmetric when Hss is symmetric and, if
+    // there are p variables, when Vps = tr(Hsp), Vpp is symmetric, and
+    // Sbsp = 0, which is the case, for example, of problems without v
+    // constraints. Its symmetry is checked directly, and a symmetric matrix
+    // is decomposed with a Bunch-Kaufman LDLT decomposition, which requires
+    // about half of the operations of the LU decomposition. The LU
+    // decomposition is used otherwise, or when LDLT rejects the matrix for
+    // being singular or ill-conditioned, so that the full-pivoting LU can
+    // still deal with linearly dependent rows (e.g., degenerate problems).
+    // If LinearSolverOptions::mixedprecision is true, the LU decomposition
+    // is computed in single precision with iterative refinement instead,
+    // which itself falls back to the full-pivoting LU decomposition when
+    // the refinement stalls.
+    //======================================================================
 
     Impl()
     {}
@@ -83,10 +108,35 @@ struct LinearSolverFullspace::Impl
         if( np) M3 << Vpbs, Vpns, Vpp, Opbs;
         if(nbs) M4 << Ibsbs, Sbsns, Sbsp, Obsbs;
 
-        lu.decompose(M);
+        symmetric = isSymmetric(M) && ldlt.decompose(M);
+
+        // In the first call, both decompositions are computed so that their
+        // workspaces are allocated before the iterations, in which either of
+        // them may be needed (see HeapAllocationGuard)
+        if(ldlt.empty())
+            ldlt.decompose(M);
+
+        mixed = !symmetric && options.mixedprecision;
+
+        // The dimension of M changes as variables become stable or unstable,
+        // and the matrix may be symmetric in some iterations and not in
+        // others, so the workspace is allocated with its largest dimension
+        if(options.mixedprecision)
+            mlu.reserve(nt);
+
+        if(mixed)
+            mlu.decompose(M);
+
+        if((!symmetric && !mixed) || lu.empty())
+            lu.decompose(M);
     }
 
     auto solve(CanonicalMatrix J, CanonicalVectorView a, CanonicalVectorRef u) -> void
+    {
+        solveMultiple(J, a, u);
+    }
+
+    auto solveMultiple(CanonicalMatrix J, CanonicalVectorsView a, CanonicalVectorsRef u) -> void
     {
         const auto dims = J.dims;
 
@@ -98,14 +148,15 @@ struct LinearSolverFullspace::Impl
         const auto nt  = dims.nt;
 
         const auto t = ns + np + nbs;
+        const auto k = a.xs.cols();
 
-        vec.resize(nt);
-        auto r = vec.head(t);
+        rhs.resize(nt, k);
+        auto r = rhs.topRows(t);
 
-        auto xbs = r.head(nbs);
-        auto xns = r.segment(nbs, nns);
-        auto p   = r.segment(nbs + nns, np);
-        auto wbs = r.tail(nbs);
+        auto xbs = r.topRows(nbs);
+        auto xns = r.middleRows(nbs, nns);
+        auto p   = r.middleRows(nbs + nns, np);
+        auto wbs = r.bottomRows(nbs);
 
         const auto axs  = a.xs;
         const auto ap   = a.p;
@@ -113,7 +164,11 @@ struct LinearSolverFullspace::Impl
 
         r << axs, ap, awbs;
 
-        lu.solve(r);
+        if(symmetric)
+            ldlt.solveMultiple(r);
+        else if(mixed)
+            mlu.solveMultiple(r);
+        else lu.solveMultiple(r);
 
         u.xs << xbs, xns;
         u.p = p;
@@ -138,6 +193,11 @@ auto LinearSolverFullspace::operator=(LinearSolverFullspace other) -> LinearSolv
     return *this;
 }
 
+auto LinearSolverFullspace::setOptions(const LinearSolverOptions& options) -> void
+{
+    pimpl->options = options;
+}
+
 auto LinearSolverFullspace::decompose(CanonicalMatrix M) -> void
 {
     pimpl->decompose(M);
@@ -148,4 +208,9 @@ auto LinearSolverFullspace::solve(CanonicalMatrix J, CanonicalVectorView a, Cano
     pimpl->solve(J, a, u);
 }
 
+auto LinearSolverFullspace::solveMultiple(CanonicalMatrix J, CanonicalVectorsView a, CanonicalVectorsRef u) -> void
+{
+    pimpl->solveMultiple(J, a, u);
+}
+
 } // namespace Optima
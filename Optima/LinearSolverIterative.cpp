@@ -0,0 +1,559 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "LinearSolverIterative.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+// Optima includes
+#include <Optima/CanonicalVector.hpp>
+#include <Optima/CanonicalMatrix.hpp>
+#include <Optima/Exception.hpp>
+#include <Optima/HeapAllocationGuard.hpp>
+#include <Optima/LinearSolverFullspace.hpp>
+#include <Optima/LU.hpp>
+#include <Optima/Utils.hpp>
+
+namespace Optima {
+
+struct LinearSolverIterative::Impl
+{
+    //======================================================================
+    // Note: The canonical linear problem solved here is:
+    //
+    //   [Hbsbs Hbsns Hbsp I    ] [xbs]   [axbs]
+    //   [Hnsbs Hnsns Hnsp Sbsnsᵀ] [xns] = [axns]
+    //   [Vpbs  Vpns  Vpp  0    ] [p  ]   [ap  ]
+    //   [I     Sbsns Sbsp 0    ] [wbs]   [awbs]
+    //
+    // The last block row gives xbs = awbs - Sbsns*xns - Sbsp*p, and the
+    // first one gives wbs = axbs - Hbsbs*xbs - Hbsns*xns - Hbsp*p. With
+    // these, the second and third block rows become a linear problem
+    // A*z = b on z = (xns, p) only. This elimination of the basic variables
+    // with the echelon form of Wx is equivalent to the use of an exact
+    // constraint preconditioner, so that every iterate satisfies the linear
+    // equality constraints. The product of A with a vector z requires only
+    // one product of [Hss Hsp] with a vector (or the call of the
+    // user-supplied Hessian product function) and products with Sbsns, Sbsp,
+    // Vps, Vpp, so no matrix is assembled or decomposed. The reduced problem
+    // is solved with the restarted GMRES method (A is not symmetric in
+    // general), right-preconditioned with the matrix P = diag(Pns, Pp):
+    //
+    //   Pns = Dns + tr(Sbsns)*Dbs*Sbsns   and   Pp = diag(Vpp - Vpbs*Sbsp),
+    //
+    // where Dbs and Dns are the diagonals of Hbsbs and Hnsns. Pns is the
+    // block of A on xns when Hss is diagonal, in which case GMRES converges
+    // in one iteration if there are no p variables. Its inverse is applied
+    // with the Woodbury formula:
+    //
+    //   inv(Pns) = inv(Dns) - inv(Dns)*tr(Sbsns)*inv(K)*Dbs*Sbsns*inv(Dns),
+    //
+    // with K = I + Dbs*Sbsns*inv(Dns)*tr(Sbsns), whose dimension is only the
+    // number of basic variables. The computation and decomposition of K
+    // require O(nbs^2 * nns + nbs^3) operations, which is small compared to
+    // the decomposition of the canonical master matrix when nw << nx.
+    //
+    // The elimination of xbs and wbs can amplify the errors in z by the
+    // entries of Sbsns, which can be large (e.g., 1e3). Thus, GMRES stops
+    // when the residual of the reduced problem is small relative to the
+    // right-hand side vector of the canonical problem (instead of b, which
+    // can be much larger than it), and the solution is only accepted if the
+    // residual of the canonical problem, computed with the recovered xbs and
+    // wbs, is also small. Otherwise, the dense solver is used instead.
+    //
+    // If a Hessian product function is given, the matrix Hss in the
+    // canonical matrix may be only an approximation (e.g., its diagonal)
+    // used for the preconditioner. Thus, the dense solver then decomposes
+    // the matrix Hss assembled column by column with the Hessian product
+    // function, which costs ns calls of this function but avoids solutions
+    // of a different linear problem than the one solved by GMRES.
+    //======================================================================
+
+    LinearSolverOptions options; ///< The options for the linear solver.
+
+    Vector dinv; ///< The inverses of the diagonal entries of Dns and Pp in the preconditioner.
+    Vector dbs;  ///< The diagonal entries of Dbs in the preconditioner.
+    Matrix Kw;   ///< The workspace for matrix K in the preconditioner.
+    Matrix Gw;   ///< The workspace for matrix Sbsns*inv(Dns).
+    Vector sw;   ///< The workspace for the vectors with dimension nbs in the application of the preconditioner.
+    Vector ew;   ///< The workspace for the vectors with dimension nns in the application of the preconditioner.
+    LU lu;       ///< The LU decomposition of matrix K in the preconditioner.
+    Vector b;    ///< The workspace for the right-hand side vector b of the reduced linear problem.
+    Vector z;    ///< The workspace for the solution vector z = (xns, p) of the reduced linear problem.
+    Vector r;    ///< The workspace for the residual vector b - A*z.
+    Vector q;    ///< The workspace for the products of matrix A with vectors.
+    Vector t;    ///< The workspace for the preconditioned vectors.
+    Matrix V;    ///< The workspace for the orthonormal basis of the Krylov subspace.
+    Matrix Hh;   ///< The workspace for the upper Hessenberg matrix in the Arnoldi process.
+    Vector cs;   ///< The workspace for the cosines of the Givens rotations.
+    Vector sn;   ///< The workspace for the sines of the Givens rotations.
+    Vector g;    ///< The workspace for the rotated residual vector in the least-squares problem of GMRES.
+    Vector y;    ///< The workspace for the solution of the least-squares problem of GMRES.
+    Vector xs;   ///< The workspace for the vector xs = (xbs, xns).
+    Vector hs;   ///< The workspace for the products Hss*xs + Hsp*p.
+    Vector ux;   ///< The workspace for the vectors given to the Hessian product function.
+    Vector hx;   ///< The workspace for the vectors computed by the Hessian product function.
+    Vector rc;   ///< The workspace for the residual vector of the canonical linear problem.
+    Matrix Hw;   ///< The workspace for the matrix Hss assembled with the Hessian product function for the dense solver.
+
+    LinearSolverFullspace fullspace; ///< The dense linear solver used when GMRES does not converge.
+    bool dense = false;              ///< The flag that indicates if GMRES failed after the last decomposition and the dense solver is used instead.
+
+    Impl()
+    {}
+
+    auto setOptions(const LinearSolverOptions& opts) -> void
+    {
+        options = opts;
+        fullspace.setOptions(opts);
+    }
+
+    auto decompose(CanonicalMatrix J) -> void
+    {
+        const auto dims = J.dims;
+
+        const auto nx  = dims.nx;
+        const auto np  = dims.np;
+        const auto nw  = dims.nw;
+        const auto nbs = dims.nbs;
+        const auto nns = dims.nns;
+
+        const auto m = std::max<Index>(options.iterative.restart, 1);
+
+        // The workspaces are sized with the largest dimensions so that they are not resized in the iterations
+        ensureMinimumDimension(dinv, nx + np);
+        ensureMinimumDimension(dbs, nx);
+        ensureMinimumDimension(Kw, nw, nw);
+        ensureMinimumDimension(Gw, nw, nx);
+        ensureMinimumDimension(sw, nw);
+        ensureMinimumDimension(ew, nx);
+        ensureMinimumDimension(b, nx + np);
+        ensureMinimumDimension(z, nx + np);
+        ensureMinimumDimension(r, nx + np);
+        ensureMinimumDimension(q, nx + np);
+        ensureMinimumDimension(t, nx + np);
+        ensureMinimumDimension(V, nx + np, m + 1);
+        ensureMinimumDimension(Hh, m + 1, m);
+        ensureMinimumDimension(cs, m);
+        ensureMinimumDimension(sn, m);
+        ensureMinimumDimension(g, m + 1);
+        ensureMinimumDimension(y, m);
+        ensureMinimumDimension(xs, nx);
+        ensureMinimumDimension(hs, nx);
+        ensureMinimumDimension(ux, nx);
+        ensureMinimumDimension(hx, nx);
+        ensureMinimumDimension(rc, nx + np + nw);
+
+        dense = false;
+
+        const auto Vpbs = J.Vps.leftCols(nbs);
+
+        auto dns = dinv.head(nns);
+        auto dp  = dinv.segment(nns, np);
+        auto db  = dbs.head(nbs);
+
+        dns = J.Hss.diagonal().tail(nns);
+        db = J.Hss.diagonal().head(nbs);
+
+        // The diagonal of Vpp - Vpbs*Sbsp
+        for(Index k = 0; k < np; ++k)
+            dp[k] = J.Vpp(k, k) - Vpbs.row(k).dot(J.Sbsp.col(k));
+
+        for(Index i = 0; i < nns + np; ++i)
+            dinv[i] = (dinv[i] != 0.0 && std::isfinite(dinv[i])) ? 1.0 / dinv[i] : 1.0;
+
+        if(nbs == 0)
+            return;
+
+        auto G = Gw.topLeftCorner(nbs, nns);
+        auto K = Kw.topLeftCorner(nbs, nbs);
+
+        G = J.Sbsns.array().rowwise() * tr(dinv.head(nns)).array();
+        K.noalias() = G * tr(J.Sbsns);
+        K.array().colwise() *= db.array();
+        K.diagonal().array() += 1.0;
+
+        lu.decompose(K);
+    }
+
+    /// Apply the inverse of the preconditioner P to a vector in-place.
+    auto precondition(CanonicalMatrix J, VectorRef v) -> void
+    {
+        const auto nbs = J.dims.nbs;
+        const auto nns = J.dims.nns;
+        const auto np  = J.dims.np;
+
+        auto vns = v.head(nns);
+        auto s = sw.head(nbs);
+        auto e = ew.head(nns);
+
+        vns.array() *= dinv.head(nns).array();
+
+        if(nbs)
+        {
+            s.noalias() = J.Sbsns * vns;
+            s.array() *= dbs.head(nbs).array();
+            lu.solve(s);
+            e.noalias() = tr(J.Sbsns) * s;
+            vns -= dinv.head(nns).cwiseProduct(e);
+        }
+
+        v.tail(np).array() *= dinv.segment(nns, np).array();
+    }
+
+    /// Compute hs = Hss*xs + Hsp*p, using the Hessian product function if given.
+    auto multiplyH(CanonicalMatrix J, VectorView xsv, VectorView p, VectorRef hsv) -> void
+    {
+        const auto nx = J.dims.nx;
+
+        if(options.iterative.hessian)
+        {
+            auto u = ux.head(nx);
+            auto hu = hx.head(nx);
+            u.fill(0.0);
+            u(J.js) = xsv;
+            {
+                const HeapAllocationGuard guard(true); // the user function may allocate
+                options.iterative.hessian(u, hu);
+            }
+            hsv = hu(J.js);
+        }
+        else if(J.isHssDiag)
+            hsv = J.Hss.diagonal().cwiseProduct(xsv);
+        else hsv.noalias() = J.Hss * xsv;
+
+        hsv.noalias() += J.Hsp * p;
+    }
+
+    /// Compute the product of the reduced matrix A with a vector z = (xns, p).
+    auto multiply(CanonicalMatrix J, VectorView zv, VectorRef Az) -> void
+    {
+        const auto dims = J.dims;
+
+        const auto ns  = dims.ns;
+        const auto np  = dims.np;
+        const auto nbs = dims.nbs;
+        const auto nns = dims.nns;
+
+        const auto zns = zv.head(nns);
+        const auto zp  = zv.tail(np);
+
+        auto xsv = xs.head(ns);
+        auto hsv = hs.head(ns);
+
+        xsv.head(nbs).setZero();
+        xsv.head(nbs).noalias() -= J.Sbsns * zns;
+        xsv.head(nbs).noalias() -= J.Sbsp * zp;
+        xsv.tail(nns) = zns;
+
+        multiplyH(J, xsv, zp, hsv);
+
+        // Note that wbs = -hs(bs) and the product tr(Sbsns)*wbs is subtracted accordingly
+        Az.head(nns) = hsv.tail(nns);
+        Az.head(nns).noalias() -= tr(J.Sbsns) * hsv.head(nbs);
+        Az.tail(np).noalias() = J.Vps * xsv;
+        Az.tail(np).noalias() += J.Vpp * zp;
+    }
+
+    /// Solve the reduced linear problem A*z = b with the restarted and preconditioned GMRES method.
+    /// @param anorm The norm of the right-hand side vector of the canonical linear problem to which the residual is relative.
+    /// @return True if the relative residual of the solution is below the tolerance.
+    auto gmres(CanonicalMatrix J, Index nr, double anorm) -> bool
+    {
+        const auto m = std::max<Index>(options.iterative.restart, 1);
+        const auto maxiters = options.iterative.maxiters;
+
+        auto bv = b.head(nr);
+        auto zv = z.head(nr);
+        auto rv = r.head(nr);
+        auto qv = q.head(nr);
+        auto tv = t.head(nr);
+
+        zv.fill(0.0);
+
+        const auto bnorm = bv.norm();
+
+        if(bnorm == 0.0)
+            return true;
+
+        const auto tol = options.iterative.tolerance * anorm;
+
+        rv = bv;
+        auto beta = bnorm;
+
+        Index iters = 0;
+
+        while(iters < maxiters)
+        {
+            V.col(0).head(nr) = rv / beta;
+            g.fill(0.0);
+            g[0] = beta;
+
+            Index k = 0; // the number of Arnoldi steps in this cycle
+            while(k < m && iters < maxiters)
+            {
+                tv = V.col(k).head(nr);
+                precondition(J, tv);
+                multiply(J, tv, qv);
+
+                // The modified Gram-Schmidt orthogonalization of the new Krylov vector
+                for(Index i = 0; i <= k; ++i)
+                {
+                    Hh(i, k) = V.col(i).head(nr).dot(qv);
+                    qv -= Hh(i, k) * V.col(i).head(nr);
+                }
+
+                const auto hnext = qv.norm();
+                Hh(k + 1, k) = hnext;
+
+                if(hnext > 0.0)
+                    V.col(k + 1).head(nr) = qv / hnext;
+
+                // Apply the previous Givens rotations to the new column of the Hessenberg matrix
+                for(Index i = 0; i < k; ++i)
+                {
+                    const auto h0 = Hh(i, k);
+                    const auto h1 = Hh(i + 1, k);
+                    Hh(i, k)     =  cs[i] * h0 + sn[i] * h1;
+                    Hh(i + 1, k) = -sn[i] * h0 + cs[i] * h1;
+                }
+
+                // Compute the Givens rotation that eliminates the subdiagonal entry
+                const auto d = std::hypot(Hh(k, k), Hh(k + 1, k));
+                if(d == 0.0)
+                    return false; // the reduced matrix is singular
+
+                cs[k] = Hh(k, k) / d;
+                sn[k] = Hh(k + 1, k) / d;
+                Hh(k, k) = d;
+                Hh(k + 1, k) = 0.0;
+                g[k + 1] = -sn[k] * g[k];
+                g[k] = cs[k] * g[k];
+
+                ++k;
+                ++iters;
+
+                if(std::abs(g[k]) <= tol || hnext == 0.0)
+                    break;
+            }
+
+            // Update the solution with the least-squares solution in the Krylov subspace
+            auto yk = y.head(k);
+            yk = g.head(k);
+            Hh.topLeftCorner(k, k).triangularView<Eigen::Upper>().solveInPlace(yk);
+            tv.noalias() = V.topLeftCorner(nr, k) * yk;
+            precondition(J, tv);
+            zv += tv;
+
+            // Compute the actual residual of the solution, which is used for the restart
+            multiply(J, zv, qv);
+            rv = bv - qv;
+            beta = rv.norm();
+
+            if(beta <= tol)
+                return true;
+        }
+
+        return false;
+    }
+
+    /// Return the norm of the residual of the canonical linear problem with the solution in xs, p, wbs and the products in hs.
+    auto residualNorm(CanonicalMatrix J, VectorView axs, VectorView ap, VectorView awbs, VectorView xsv, VectorView p, VectorView wbs) -> double
+    {
+        const auto dims = J.dims;
+
+        const auto ns  = dims.ns;
+        const auto np  = dims.np;
+        const auto nbs = dims.nbs;
+        const auto nns = dims.nns;
+
+        auto rs  = rc.head(ns);
+        auto rp  = rc.segment(ns, np);
+        auto rbs = rc.segment(ns + np, nbs);
+
+        rs = axs - hs.head(ns);
+        rs.head(nbs) -= wbs;
+        rs.tail(nns).noalias() -= tr(J.Sbsns) * wbs;
+
+        rp = ap;
+        rp.noalias() -= J.Vps * xsv;
+        rp.noalias() -= J.Vpp * p;
+
+        rbs = awbs - xsv.head(nbs);
+        rbs.noalias() -= J.Sbsns * xsv.tail(nns);
+        rbs.noalias() -= J.Sbsp * p;
+
+        return rc.head(ns + np + nbs).norm();
+    }
+
+    auto solve(CanonicalMatrix J, CanonicalVectorView a, CanonicalVectorRef u) -> void
+    {
+        solveMultiple(J, a, u);
+    }
+
+    /// Return the canonical matrix used by the dense solver, with Hss assembled with the Hessian product function if given.
+    auto denseMatrix(CanonicalMatrix J) -> CanonicalMatrix
+    {
+        if(!options.iterative.hessian)
+            return J;
+
+        const auto ns = J.dims.ns;
+
+        return { J.dims, Hw.topLeftCorner(ns, ns), J.Hsp, J.Vps, J.Vpp, J.Sbsns, J.Sbsp, J.Rbs, J.jb, J.jn, J.js, J.ju, false };
+    }
+
+    /// Decompose the canonical matrix with the dense solver after GMRES failed.
+    auto decomposeDense(CanonicalMatrix J) -> void
+    {
+        const auto nx = J.dims.nx;
+        const auto ns = J.dims.ns;
+
+        if(options.iterative.hessian)
+        {
+            Hw.resize(ns, ns);
+            auto u = ux.head(nx);
+            auto hu = hx.head(nx);
+            u.fill(0.0);
+            for(Index j = 0; j < ns; ++j)
+            {
+                u[J.js[j]] = 1.0;
+                options.iterative.hessian(u, hu);
+                Hw.col(j) = hu(J.js);
+                u[J.js[j]] = 0.0;
+            }
+        }
+
+        fullspace.decompose(denseMatrix(J));
+        dense = true;
+    }
+
+    auto solveMultiple(CanonicalMatrix J, CanonicalVectorsView a, CanonicalVectorsRef u) -> void
+    {
+        if(dense)
+            return fullspace.solveMultiple(denseMatrix(J), a, u);
+
+        const auto dims = J.dims;
+
+        const auto ns  = dims.ns;
+        const auto np  = dims.np;
+        const auto nbs = dims.nbs;
+        const auto nns = dims.nns;
+
+        const auto nr = nns + np;
+        const auto k = a.xs.cols();
+
+        auto xsv = xs.head(ns);
+        auto hsv = hs.head(ns);
+
+        auto bns = b.head(nns);
+        auto bp  = b.segment(nns, np);
+        auto zns = z.head(nns);
+        auto zp  = z.segment(nns, np);
+
+        for(Index c = 0; c < k; ++c)
+        {
+            const auto axbs = a.xs.col(c).head(nbs);
+            const auto axns = a.xs.col(c).tail(nns);
+            const auto ap   = a.p.col(c);
+            const auto awbs = a.wbs.col(c);
+
+            // The right-hand side vector b = (axns, ap) - A*0 - (contributions of xbs = awbs and wbs = axbs - Hbsbs*awbs)
+            zp.fill(0.0);
+            xsv.head(nbs) = awbs;
+            xsv.tail(nns).fill(0.0);
+            multiplyH(J, xsv, zp, hsv);
+            hsv.head(nbs) -= axbs; // hs(bs) = -wbs
+            bns = axns - hsv.tail(nns);
+            bns.noalias() += tr(J.Sbsns) * hsv.head(nbs);
+            bp = ap;
+            bp.noalias() -= J.Vps * xsv;
+
+            const auto anorm = std::sqrt(a.xs.col(c).squaredNorm() + ap.squaredNorm() + awbs.squaredNorm());
+
+            auto converged = gmres(J, nr, anorm);
+
+            if(converged)
+            {
+                // Recover xbs and wbs from the solution z = (xns, p)
+                xsv.head(nbs) = awbs;
+                xsv.head(nbs).noalias() -= J.Sbsns * zns;
+                xsv.head(nbs).noalias() -= J.Sbsp * zp;
+                xsv.tail(nns) = zns;
+                multiplyH(J, xsv, zp, hsv);
+
+                u.xs.col(c) = xsv;
+                u.p.col(c) = zp;
+                u.wbs.col(c) = axbs - hsv.head(nbs);
+
+                const auto rnorm = residualNorm(J, a.xs.col(c), ap, awbs, xsv, zp, u.wbs.col(c));
+
+                converged = rnorm <= options.iterative.tolerance * anorm;
+            }
+
+            if(!converged)
+            {
+                // Solve all linear problems with the dense solver, which
+                // requires heap allocation only in this exceptional case
+                const HeapAllocationGuard guard(true);
+                decomposeDense(J);
+                return fullspace.solveMultiple(denseMatrix(J), a, u);
+            }
+        }
+    }
+};
+
+LinearSolverIterative::LinearSolverIterative()
+: pimpl(new Impl())
+{}
+
+LinearSolverIterative::LinearSolverIterative(const LinearSolverIterative& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+LinearSolverIterative::~LinearSolverIterative()
+{}
+
+auto LinearSolverIterative::operator=(LinearSolverIterative other) -> LinearSolverIterative&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto LinearSolverIterative::setOptions(const LinearSolverOptions& options) -> void
+{
+    pimpl->setOptions(options);
+}
+
+auto LinearSolverIterative::decompose(CanonicalMatrix M) -> void
+{
+    pimpl->decompose(M);
+}
+
+auto LinearSolverIterative::solve(CanonicalMatrix J, CanonicalVectorView a, CanonicalVectorRef u) -> void
+{
+    pimpl->solve(J, a, u);
+}
+
+auto LinearSolverIterative::solveMultiple(CanonicalMatrix J, CanonicalVectorsView a, CanonicalVectorsRef u) -> void
+{
+    pimpl->solveMultiple(J, a, u);
+}
+
+} // namespace Optima
@@ -20,26 +20,73 @@
 // C++ includes
 #include <cassert>
 
+// Eigen includes
+#include <Eigen/Cholesky>
+
 // Optima includes
 #include <Optima/CanonicalVector.hpp>
 #include <Optima/CanonicalMatrix.hpp>
 #include <Optima/Exception.hpp>
 #include <Optima/LU.hpp>
+#include <Optima/MixedPrecisionLU.hpp>
+#include <Optima/Utils.hpp>
 
 namespace Optima {
 
 struct LinearSolverNullspace::Impl
 {
-    Vector ax;  ///< The workspace for the right-hand side vectors ax
-    Vector ap;  ///< The workspace for the right-hand side vectors ap
-    Vector aw;  ///< The workspace for the right-hand side vectors aw
+    Matrix ax;  ///< The workspace for the right-hand side vectors ax
+    Matrix ap;  ///< The workspace for the right-hand side vectors ap
+    Matrix aw;  ///< The workspace for the right-hand side vectors aw
     Matrix Hxx; ///< The workspace for the auxiliary matrices Hss.
     Matrix Hxp; ///< The workspace for the auxiliary matrices Hsp.
     Matrix Vpx; ///< The workspace for the auxiliary matrices Vps.
     Matrix Vpp; ///< The workspace for the auxiliary matrices Vpp.
     Matrix Mw;  ///< The workspace for the matrix M in the decompose and solve methods.
-    Vector rw;  ///< The workspace for the vector r in the decompose and solve methods.
+    Matrix rw;  ///< The workspace for the vectors r in the decompose and solve methods.
+    Matrix Lw;  ///< The workspace for the reduced Hessian matrix Hr and its Cholesky factor L.
+    Matrix Gw;  ///< The workspace for the matrix G = Hnsbe - tr(Sbens)*Hbebe.
+    Matrix Yw;  ///< The workspace for the matrix Y = inv(Hr)*Hrp.
+    Matrix Vw;  ///< The workspace for the matrix Vpr = Vpns - Vpbe*Sbens.
     LU lu;      ///< The LU decomposition solver.
+    MixedPrecisionLU mlu; ///< The single-precision LU decomposition solver with iterative refinement.
+
+    LinearSolverOptions options; ///< The options for the linear solver.
+
+    bool cholesky = false; ///< The flag indicating the last decomposition was performed with the Cholesky decomposition of the reduced Hessian matrix.
+
+    bool mixed = false; ///< The flag indicating the last decomposition was performed with the single-precision LU decomposition.
+
+    //======================================================================
+    // Note on the Cholesky decomposition of the reduced Hessian matrix
+    //======================================================================
+    // After the elimination of the implicit basic variables xbi, the linear
+    // problem on the unknowns (xbe, xns, p, wbe) is:
+    //
+    //   Hbebe*xbe + Hbens*xns + Hbep*p + wbe          = abe
+    //   Hnsbe*xbe + Hnsns*xns + Hnsp*p + tr(Sbens)*wbe = ans
+    //   Vpbe*xbe  + Vpns*xns  + Vpp*p                  = ap
+    //   xbe       + Sbens*xns + Sbep*p                 = awbe
+    //
+    // Eliminating xbe with the last equation and wbe with the first one
+    // produces the reduced problem:
+    //
+    //   Hr*xns  + Hrp*p  = ans - tr(Sbens)*abe - G*awbe
+    //   Vpr*xns + Vppr*p = ap - Vpbe*awbe
+    //
+    // where G = Hnsbe - tr(Sbens)*Hbebe and:
+    //
+    //   Hr   = Hnsns - tr(Sbens)*Hbens - G*Sbens
+    //   Hrp  = Hnsp - tr(Sbens)*Hbep - G*Sbep
+    //   Vpr  = Vpns - Vpbe*Sbens
+    //   Vppr = Vpp - Vpbe*Sbep
+    //
+    // The reduced Hessian matrix Hr is symmetric if Hss is symmetric, and
+    // positive definite for convex problems. It is then decomposed in place
+    // with a Cholesky decomposition. The p unknowns, if any, are obtained
+    // from the LU decomposition of the Schur complement Vppr - Vpr*Y, where
+    // Y = inv(Hr)*Hrp.
+    //======================================================================
 
     Impl()
     {}
@@ -138,15 +185,113 @@ struct LinearSolverNullspace::Impl
         Hnsns.noalias() -= tr(Sbins) * Hbins;
         Hnsp.noalias()  -= tr(Sbins) * Hbip;
 
+        cholesky = options.cholesky && isSymmetric(J.Hss) && decomposeCholesky(J);
+
+        if(cholesky)
+            return;
+
         if(nbe) M1 << Hbebe, Hbens, Hbep, Ibebe;
         if(nns) M2 << Hnsbe, Hnsns, Hnsp, tr(Sbens);
         if( np) M3 << Vpbe, Vpns, Vpp, Opbe;
         if(nbe) M4 << Ibebe, Sbens, Sbep, Obebe;
 
-        if(t) lu.decompose(M);
+        mixed = options.mixedprecision;
+
+        // The dimension of M changes as variables become basic or non-basic
+        // and stable or unstable, so the workspace is allocated with its largest dimension
+        if(mixed)
+            mlu.reserve(nt);
+
+        if(t && mixed)
+            mlu.decompose(M);
+        else if(t)
+            lu.decompose(M);
+    }
+
+    /// Decompose the reduced Hessian matrix with a Cholesky decomposition and return false if it is not positive definite.
+    auto decomposeCholesky(CanonicalMatrix J) -> bool
+    {
+        const auto dims = J.dims;
+
+        const auto nx  = dims.nx;
+        const auto ns  = dims.ns;
+        const auto nbe = dims.nbe;
+        const auto nns = dims.nns;
+        const auto np  = dims.np;
+        const auto nw  = dims.nw;
+
+        const auto Hss = Hxx.topLeftCorner(ns, ns);
+        const auto Hsp = Hxp.topRows(ns);
+        const auto Vps = Vpx.leftCols(ns);
+
+        const auto Hbebe = Hss.topLeftCorner(nbe, nbe);
+        const auto Hbens = Hss.topRows(nbe).rightCols(nns);
+        const auto Hnsbe = Hss.bottomRows(nns).leftCols(nbe);
+        const auto Hnsns = Hss.bottomRightCorner(nns, nns);
+
+        const auto Hbep = Hsp.topRows(nbe);
+        const auto Hnsp = Hsp.bottomRows(nns);
+
+        const auto Vpbe = Vps.leftCols(nbe);
+        const auto Vpns = Vps.rightCols(nns);
+
+        const auto Sbens = J.Sbsns.topRows(nbe);
+        const auto Sbep  = J.Sbsp.topRows(nbe);
+
+        Lw.resize(nx, nx);
+        Gw.resize(nx, nw);
+        Yw.resize(nx, np);
+        Vw.resize(np, nx);
+
+        auto Hr  = Lw.topLeftCorner(nns, nns);
+        auto G   = Gw.topLeftCorner(nns, nbe);
+        auto Hrp = Yw.topRows(nns);
+        auto Vpr = Vw.leftCols(nns);
+
+        G = Hnsbe;
+        G.noalias() -= tr(Sbens) * Hbebe;
+
+        Hr = Hnsns;
+        Hr.noalias() -= tr(Sbens) * Hbens;
+        Hr.noalias() -= G * Sbens;
+
+        Eigen::LLT<Eigen::Ref<Matrix>> llt(Hr); // the Cholesky factor L is computed in place, in the lower triangular part of Hr
+
+        if(llt.info() != Eigen::Success)
+            return false;
+
+        if(np == 0)
+            return true;
+
+        Hrp = Hnsp;
+        Hrp.noalias() -= tr(Sbens) * Hbep;
+        Hrp.noalias() -= G * Sbep;
+
+        Vpr = Vpns;
+        Vpr.noalias() -= Vpbe * Sbens;
+
+        Vpp.noalias() -= Vpbe * Sbep;
+
+        const auto L = Hr.triangularView<Eigen::Lower>();
+
+        L.solveInPlace(Hrp);
+        L.transpose().solveInPlace(Hrp);
+
+        auto Y = Hrp;
+
+        Vpp.noalias() -= Vpr * Y;
+
+        lu.decompose(Vpp);
+
+        return true;
     }
 
     auto solve(CanonicalMatrix J, CanonicalVectorView a, CanonicalVectorRef u) -> void
+    {
+        solveMultiple(J, a, u);
+    }
+
+    auto solveMultiple(CanonicalMatrix J, CanonicalVectorsView a, CanonicalVectorsRef u) -> void
     {
         const auto dims = J.dims;
 
@@ -170,17 +315,21 @@ struct LinearSolverNullspace::Impl
         const auto Hbsns = Hss.topRows(nbs).rightCols(nns);
         const auto Hnsbs = Hss.bottomRows(nns).leftCols(nbs);
 
+        const auto Hbebe = Hbsbs.topRows(nbe).leftCols(nbe);
         const auto Hbebi = Hbsbs.topRows(nbe).rightCols(nbi);
         const auto Hbibe = Hbsbs.bottomRows(nbi).leftCols(nbe);
         const auto Hbibi = Hbsbs.bottomRows(nbi).rightCols(nbi);
 
+        const auto Hbens = Hbsns.topRows(nbe);
         const auto Hbins = Hbsns.bottomRows(nbi);
         const auto Hnsbi = Hnsbs.rightCols(nbi);
 
         const auto Hbsp = Hsp.topRows(nbs);
+        const auto Hbep = Hbsp.topRows(nbe);
         const auto Hbip = Hbsp.bottomRows(nbi);
 
         const auto Vpbs = Vps.leftCols(nbs);
+        const auto Vpbe = Vpbs.leftCols(nbe);
         const auto Vpbi = Vpbs.rightCols(nbi);
 
         const auto Sbsns = J.Sbsns;
@@ -192,17 +341,19 @@ struct LinearSolverNullspace::Impl
         const auto Sbep = Sbsp.topRows(nbe);
         const auto Sbip = Sbsp.bottomRows(nbi);
 
-        ax.resize(nx);
-        auto as  = ax.head(ns);
-        auto abs = as.head(nbs);
-        auto ans = as.tail(nns);
-        auto abe = abs.head(nbe);
-        auto abi = abs.tail(nbi);
+        const auto k = a.xs.cols();
 
-        aw.resize(nw);
-        auto awbs = aw.head(nbs);
-        auto awbe = awbs.head(nbe);
-        auto awbi = awbs.tail(nbi);
+        ax.resize(nx, k);
+        auto as  = ax.topRows(ns);
+        auto abs = as.topRows(nbs);
+        auto ans = as.bottomRows(nns);
+        auto abe = abs.topRows(nbe);
+        auto abi = abs.bottomRows(nbi);
+
+        aw.resize(nw, k);
+        auto awbs = aw.topRows(nbs);
+        auto awbe = awbs.topRows(nbe);
+        auto awbi = awbs.bottomRows(nbi);
 
         as = a.xs;
         ap = a.p;
@@ -213,27 +364,68 @@ struct LinearSolverNullspace::Impl
         ans.noalias() -= Hnsbi * awbi;
         ap.noalias()  -= Vpbi * awbi;
 
-        ans -= tr(Sbins) * abi;
+        ans.noalias() -= tr(Sbins) * abi;
 
         const auto t = nbe + nns + np + nbe;
 
-        rw.resize(nt);
-        auto r = rw.head(t);
-
-        auto dxbe = r.head(nbe);
-        auto dxns = r.segment(nbe, nns);
-        auto dp   = r.segment(nbe + nns, np);
-        auto dwbe = r.tail(nbe);
-
-        if(t) r << abe, ans, ap, awbe;
-
-        if(t) lu.solve(r);
+        rw.resize(nt, k);
+        auto r = rw.topRows(t);
+
+        auto dxbe = r.topRows(nbe);
+        auto dxns = r.middleRows(nbe, nns);
+        auto dp   = r.middleRows(nbe + nns, np);
+        auto dwbe = r.bottomRows(nbe);
+
+        if(cholesky)
+        {
+            const auto L = Lw.topLeftCorner(nns, nns).triangularView<Eigen::Lower>();
+            const auto G = Gw.topLeftCorner(nns, nbe);
+            const auto Y = Yw.topRows(nns);
+            const auto Vpr = Vw.leftCols(nns);
+
+            ans.noalias() -= tr(Sbens) * abe;
+            ans.noalias() -= G * awbe;
+            ap.noalias()  -= Vpbe * awbe;
+
+            L.solveInPlace(ans);
+            L.transpose().solveInPlace(ans);
+
+            if(np)
+            {
+                ap.noalias() -= Vpr * ans;
+                lu.solveMultiple(ap);
+                ans.noalias() -= Y * ap;
+            }
+
+            dxns = ans;
+            dp = ap;
+            dxbe = awbe;
+            dxbe.noalias() -= Sbens * dxns;
+            dxbe.noalias() -= Sbep * dp;
+            dwbe = abe;
+            dwbe.noalias() -= Hbebe * dxbe;
+            dwbe.noalias() -= Hbens * dxns;
+            dwbe.noalias() -= Hbep * dp;
+        }
+        else
+        {
+            if(t) r << abe, ans, ap, awbe;
+
+            if(t && mixed)
+                mlu.solveMultiple(r);
+            else if(t)
+                lu.solveMultiple(r);
+        }
 
         auto dxbi = awbi;
         auto dwbi = abi;
 
-        dxbi.noalias() = awbi - Sbins*dxns - Sbip*dp;
-        dwbi.noalias() = abi - Hbibe*dxbe - Hbins*dxns - Hbip*dp;
+        dxbi.noalias() -= Sbins*dxns;
+        dxbi.noalias() -= Sbip*dp;
+
+        dwbi.noalias() -= Hbibe*dxbe;
+        dwbi.noalias() -= Hbins*dxns;
+        dwbi.noalias() -= Hbip*dp;
 
         u.xs << dxbe, dxbi, dxns;
         u.p = dp;
@@ -258,6 +450,11 @@ auto LinearSolverNullspace::operator=(LinearSolverNullspace other) -> LinearSolv
     return *this;
 }
 
+auto LinearSolverNullspace::setOptions(const LinearSolverOptions& options) -> void
+{
+    pimpl->options = options;
+}
+
 auto LinearSolverNullspace::decompose(CanonicalMatrix M) -> void
 {
     pimpl->decompose(M);
@@ -268,4 +465,9 @@ auto LinearSolverNullspace::solve(CanonicalMatrix J, CanonicalVectorView a, Cano
     pimpl->solve(J, a, u);
 }
 
+auto LinearSolverNullspace::solveMultiple(CanonicalMatrix J, CanonicalVectorsView a, CanonicalVectorsRef u) -> void
+{
+    pimpl->solveMultiple(J, a, u);
+}
+
 } // namespace Optima
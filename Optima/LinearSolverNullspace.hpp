@@ -24,6 +24,7 @@
 #include <Optima/MasterDims.hpp>
 #include <Optima/CanonicalMatrix.hpp>
 #include <Optima/CanonicalVector.hpp>
+#include <Optima/LinearSolverOptions.hpp>
 
 namespace Optima {
 
@@ -43,6 +44,9 @@ public:
     /// Assign a LinearSolverNullspace instance to this.
     auto operator=(LinearSolverNullspace other) -> LinearSolverNullspace&;
 
+    /// Set the options for the linear solver.
+    auto setOptions(const LinearSolverOptions& options) -> void;
+
     /// Decompose the canonical matrix.
     auto decompose(CanonicalMatrix M) -> void;
 
@@ -55,6 +59,15 @@ public:
     /// @param[out] u The solution  vector in the canonical linear problem.
     auto solve(CanonicalMatrix M, CanonicalVectorView a, CanonicalVectorRef u) -> void;
 
+    /// Solve the linear problem in its canonical form for multiple right-hand side vectors.
+    /// Using this method presumes method @ref decompose has already been
+    /// called. The columns in the members of `a` and `u` are the right-hand
+    /// side vectors and the corresponding solution vectors.
+    /// @param M The canonical matrix in the canonical linear problem.
+    /// @param a The right-hand side canonical vectors in the canonical linear problem.
+    /// @param[out] u The solution vectors in the canonical linear problem.
+    auto solveMultiple(CanonicalMatrix M, CanonicalVectorsView a, CanonicalVectorsRef u) -> void;
+
 private:
     struct Impl;
 
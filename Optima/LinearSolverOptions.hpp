@@ -17,7 +17,12 @@
 
 #pragma once
 
+// C++ includes
+#include <functional>
+
 // Optima includes
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
 
 namespace Optima {
 
@@ -50,6 +55,81 @@ enum class LinearSolverMethod
     /// n_x}, and matrix \eq{W_x}, \eq{n_w \times n_x}.
     /// @warning This method should only be used when the Hessian matrix is diagonal.
     Rangespace,
+
+    /// This method solves the linear problem with a sparse LU decomposition of the master matrix.
+    /// This method assembles the same matrix of dimension
+    /// \eq{(n_x+n_p+n_w)\times(n_x+n_p+n_w)} as method Fullspace, but stores
+    /// only its non-zero entries. The fill-reducing ordering of the
+    /// decomposition is computed only when the sparsity pattern of the matrix
+    /// changes, so that the iterations with the same partition of the
+    /// variables perform only the numeric factorization. This method is
+    /// suitable for large problems in which \eq{H_{xx}} and \eq{W_x} are mostly
+    /// zeros (e.g., with thousands of variables), for which the dense
+    /// decompositions of the other methods are too costly. If the sparse
+    /// decomposition fails (e.g., because the matrix is singular), the
+    /// linear problem is solved as in method Fullspace.
+    Sparse,
+
+    /// This method solves the linear problem with a matrix-free Krylov method (GMRES).
+    /// This method eliminates the basic variables with the echelon form of the
+    /// matrix \eq{W_x}, which is equivalent to using an exact constraint
+    /// preconditioner, and solves the remaining linear problem of dimension
+    /// \eq{n_x+n_p-n_w} with the restarted GMRES method preconditioned with
+    /// the diagonal of the reduced matrix. No matrix is assembled or decomposed,
+    /// and only products of the blocks of the canonical master matrix with
+    /// vectors are computed (or of \eq{H_{xx}} with vectors, using
+    /// LinearSolverIterativeOptions::hessian). This method is suitable for
+    /// large problems in which the dense decompositions of the other methods
+    /// are too costly. If GMRES does not converge or the solution is not
+    /// accurate enough (see LinearSolverIterativeOptions::tolerance), the
+    /// linear problem is solved as in method Fullspace.
+    Iterative,
+
+    /// This method selects one of the methods Fullspace, Nullspace and Rangespace whenever a new matrix is decomposed.
+    /// The selected method is the one with the least estimated cost for the
+    /// decomposition of the canonical master matrix, given its dimensions
+    /// and whether \eq{H_{xx}} is diagonal (required by method
+    /// Rangespace). The estimates can be corrected with the wall times
+    /// measured in the first decompositions (see
+    /// LinearSolverOptions::calibrate). If a method produces an inaccurate
+    /// solution (i.e., its relative backward error exceeds 1e-8, e.g., because
+    /// of a singular reduced matrix), the linear problem is decomposed and
+    /// solved again with the next best method, and the failed method is not
+    /// selected again until the next decomposition.
+    Automatic,
+};
+
+/// Used as function signature for functions that compute the product of the Hessian matrix *Hxx* with a vector.
+/// @param u The vector *u* with dimension *nx*.
+/// @param[out] Hu The product *Hxx * u*.
+using HessianProductFunction = std::function<void(VectorView u, VectorRef Hu)>;
+
+/// Used to specify the options for method Iterative in the solution of linear problems.
+struct LinearSolverIterativeOptions
+{
+    /// The tolerance for the residual of the linear problem relative to its right-hand side.
+    /// GMRES stops when the residual of the reduced linear problem satisfies
+    /// this tolerance, and the solution is accepted only if the residual of
+    /// the canonical linear problem, with the recovered basic variables and
+    /// Lagrange multipliers, satisfies it too. A less strict tolerance results in inexact Newton steps that are
+    /// cheaper to compute, which may still be sufficient far from the
+    /// solution of the optimization problem.
+    double tolerance = 1.0e-12;
+
+    /// The maximum number of GMRES iterations, after which the linear problem is solved as in method Fullspace.
+    Index maxiters = 500;
+
+    /// The number of GMRES iterations after which the Krylov basis is discarded and GMRES is restarted.
+    Index restart = 50;
+
+    /// The function that computes the product of the Hessian matrix *Hxx* with a vector (optional).
+    /// If given, this function is used instead of the matrix *Hxx* in the
+    /// master matrix, which is then used only for the preconditioner of the
+    /// GMRES method (e.g., it can be a diagonal approximation of the Hessian
+    /// matrix, see ObjectiveResult::diagfxx). If GMRES does not converge,
+    /// the matrix *Hss* for the dense solver is assembled with this function
+    /// instead, which is then called once for each stable variable.
+    HessianProductFunction hessian;
 };
 
 /// Used to specify the options for the solution of linear problems.
@@ -58,6 +138,41 @@ struct LinearSolverOptions
 {
     /// The method for solving the linear problems.
     LinearSolverMethod method = LinearSolverMethod::Nullspace;
+
+    /// The flag that indicates if method Automatic should measure the wall
+    /// time of the decompositions to correct its cost estimates. If true,
+    /// every method whose estimated cost is close to the least one is used
+    /// once so that its wall time is measured. Note that the selection of
+    /// the methods then depends on the timings of the current machine.
+    bool calibrate = false;
+
+    /// The flag that indicates if method Nullspace should use a Cholesky decomposition of the reduced Hessian matrix.
+    /// If true, method Nullspace eliminates the basic variables from the
+    /// linear problem and decomposes the resulting reduced (projected)
+    /// Hessian matrix on the non-basic stable variables with a Cholesky
+    /// decomposition, instead of decomposing a larger augmented matrix with a
+    /// full-pivoting LU decomposition. This is considerably faster for convex
+    /// problems (e.g., Gibbs energy minimization), for which the reduced
+    /// Hessian matrix is positive definite. If the Hessian matrix is not
+    /// symmetric or the Cholesky decomposition fails (e.g., because the
+    /// reduced Hessian matrix is not positive definite), the full-pivoting LU
+    /// decomposition is used instead.
+    bool cholesky = false;
+
+    /// The flag that indicates if methods Fullspace and Nullspace should decompose matrices in single precision.
+    /// If true, the LU decompositions of the assembled matrices in methods
+    /// Fullspace and Nullspace are computed in single precision, which is
+    /// about twice as fast as in double precision, and the solutions are
+    /// refined iteratively to double-precision accuracy (see class
+    /// MixedPrecisionLU). If the refinement stalls (e.g., for singular or
+    /// very ill-conditioned matrices), the matrix is decomposed in double
+    /// precision instead. Symmetric matrices in method Fullspace are still
+    /// decomposed with the LDLT decomposition, and the Cholesky decomposition
+    /// in method Nullspace (see @ref cholesky) is not affected.
+    bool mixedprecision = false;
+
+    /// The options for method Iterative.
+    LinearSolverIterativeOptions iterative;
 };
 
 } // namespace Optima
@@ -30,22 +30,108 @@ namespace Optima {
 
 struct LinearSolverRangespace::Impl
 {
-    Vector ax;        ///< The workspace for the right-hand side vector ax
-    Vector ap;        ///< The workspace for the right-hand side vector ap
-    Vector aw;        ///< The workspace for the right-hand side vector aw
+    Matrix ax;        ///< The workspace for the right-hand side vectors ax
+    Matrix ap;        ///< The workspace for the right-hand side vectors ap
+    Matrix aw;        ///< The workspace for the right-hand side vectors aw
     Vector Hd;        ///< The workspace for the diagonal entries in the Hss matrix.
     Matrix Tw;        ///< The workspace for the Tbb = Sbn*inv(Hnn)*tr(Sbn) matrix.
     Matrix Mw;        ///< The workspace for the M matrix in decompose and solve methods.
-    Vector rw;        ///< The workspace for the r vector in solve method.
-    Vector sw;        ///< The workspace for the s vector in solve method.
+    Matrix rw;        ///< The workspace for the r vectors in solve method.
+    Matrix sw;        ///< The workspace for the s vectors in solve method.
+    Matrix yw;        ///< The workspace for intermediate vectors in solve method.
     Matrix barHsp;    ///< The workspace for matrix bar(Hsp)
     Matrix barVps;    ///< The workspace for matrix bar(Vps)
     Matrix barSbsns;  ///< The workspace for matrix bar(Sbsns)
+    Matrix Wpx;       ///< The workspace for matrix bar(Vpne)*tr(Sbine)
+    Matrix Sbsnew;    ///< The copy of matrix Sbsne used in the last computation of Tbsbs.
+    Vector Hnenew;    ///< The copy of the diagonal entries Hnene used in the last computation of Tbsbs.
+    Indices Tnzp;     ///< The positions in Tnzi where the structural nonzeros of each column of Sbsnew start.
+    Indices Tnzi;     ///< The row indices of the structural nonzeros in the columns of Sbsnew.
+    Index nbsT = -1;  ///< The number of rows in Sbsnew.
+    Index nneT = -1;  ///< The number of columns in Sbsnew.
+    bool sparseT = false; ///< The flag indicating Tbsbs is assembled from the structural nonzeros of Sbsnew instead of a dense product.
     LU lu;            ///< The LU decomposition solver.
 
+    //======================================================================
+    // Note on the computation of Tbsbs = Sbsne*inv(Hnene)*tr(Sbsne)
+    //======================================================================
+    // This Gram-like product dominates the cost of decompose. Matrix Sbsne
+    // only changes when the basic variables or the stable variables change,
+    // whereas Hnene changes in every iteration. Thus, the nonzero structure
+    // of Sbsne is cached and only recomputed when Sbsne changes. If Sbsne is
+    // sparse enough, Tbsbs is accumulated column by column from the outer
+    // products of the structural nonzeros of Sbsne, at a cost proportional
+    // to the sum of the squares of the column nonzeros. Otherwise, only the
+    // lower triangular part of Tbsbs is computed with a dense product. In
+    // both cases, the upper triangular part is copied from the lower one.
+    // Tbsbs is not computed again if both Sbsne and Hnene are unchanged.
+    //======================================================================
+
     Impl()
     {}
 
+    /// Update the matrix Tbsbs = Sbsne*inv(Hnene)*tr(Sbsne) with barSbsne = Sbsne*inv(Hnene).
+    auto updateTbsbs(MatrixView Sbsne, VectorView Hnene, MatrixView barSbsne, MatrixRef Tbsbs) -> void
+    {
+        const auto nbs = Sbsne.rows();
+        const auto nne = Sbsne.cols();
+
+        const auto sameS = nbs == nbsT && nne == nneT && Sbsnew.topLeftCorner(nbs, nne) == Sbsne;
+
+        if(sameS && Hnenew.head(nne) == Hnene)
+            return;
+
+        if(!sameS)
+        {
+            Sbsnew.resize(Tw.rows(), Hd.rows()); // no reallocation if dimensions unchanged
+            Hnenew.resize(Hd.rows());
+            Tnzp.resize(Hd.rows() + 1);
+            Tnzi.resize(Sbsnew.size());
+
+            Sbsnew.topLeftCorner(nbs, nne) = Sbsne;
+            nbsT = nbs;
+            nneT = nne;
+
+            double cost = 0.0; // the cost of accumulating Tbsbs from the outer products of the columns of Sbsne
+            Index k = 0;
+            for(Index j = 0; j < nne; ++j)
+            {
+                Tnzp[j] = k;
+                for(Index i = 0; i < nbs; ++i)
+                    if(Sbsne(i, j) != 0.0)
+                        Tnzi[k++] = i;
+                const double nnzj = k - Tnzp[j];
+                cost += nnzj * nnzj;
+            }
+            Tnzp[nne] = k;
+
+            sparseT = cost < 0.25 * nbs * nbs * nne; // dense products are considerably faster per operation than this accumulation
+        }
+
+        Hnenew.head(nne) = Hnene;
+
+        if(sparseT)
+        {
+            Tbsbs.triangularView<Eigen::Lower>().setZero();
+            for(Index j = 0; j < nne; ++j)
+            {
+                const auto begin = Tnzp[j];
+                const auto end = Tnzp[j + 1];
+                for(Index b = begin; b < end; ++b)
+                {
+                    const auto ib = Tnzi[b];
+                    const auto sb = barSbsne(ib, j);
+                    for(Index a = b; a < end; ++a)
+                        Tbsbs(Tnzi[a], ib) += Sbsne(Tnzi[a], j) * sb;
+                }
+            }
+        }
+        else Tbsbs.triangularView<Eigen::Lower>() = Sbsne * tr(barSbsne);
+
+        for(Index j = 0; j + 1 < nbs; ++j)
+            Tbsbs.row(j).tail(nbs - j - 1) = tr(Tbsbs.col(j).tail(nbs - j - 1));
+    }
+
     auto decompose(CanonicalMatrix J) -> void
     {
         const auto dims = J.dims;
@@ -88,9 +174,6 @@ struct LinearSolverRangespace::Impl
         const auto Vpbi = Vpbs.rightCols(nbi);
         const auto Vpni = Vpns.rightCols(nni);
 
-        const auto Ibebe = identity(nbe, nbe);
-        const auto Ibibi = identity(nbi, nbi);
-
         Hd.resize(nx);
         auto Hs = Hd.head(ns);
 
@@ -103,9 +186,6 @@ struct LinearSolverRangespace::Impl
         const auto Hnene = Hnsns.head(nne);
         const auto Hnini = Hnsns.tail(nni);
 
-        const auto invHbebe = diag(inv(Hbebe));
-        const auto invHnene = diag(inv(Hnene));
-
         barHsp.resize(nx, np);
         barVps.resize(np, nx);
         barSbsns.resize(nw, nx);
@@ -118,17 +198,25 @@ struct LinearSolverRangespace::Impl
         auto barSbene = barSbsne.topRows(nbe);
         auto barSbine = barSbsne.bottomRows(nbi);
 
-        barHbep  = invHbebe * Hbep;
-        barHnep  = invHnene * Hnep;
-        barVpbe  = Vpbe * invHbebe;
-        barVpne  = Vpne * invHnene;
-        barSbene = Sbene * invHnene;
-        barSbine = Sbine * invHnene;
+        barHbep  = Hbep;
+        barHnep  = Hnep;
+        barVpbe  = Vpbe;
+        barVpne  = Vpne;
+        barSbsne = Sbsne;
+
+        barHbep.array().colwise() /= Hbebe.array();
+        barHnep.array().colwise() /= Hnene.array();
+        barVpbe.array().rowwise() /= tr(Hbebe).array();
+        barVpne.array().rowwise() /= tr(Hnene).array();
+        barSbsne.array().rowwise() /= tr(Hnene).array();
+
+        if(Tw.rows() != nw)
+            nbsT = -1; // Tbsbs is lost when Tw is resized below
 
         Tw.resize(nw, nw);
         auto Tbsbs = Tw.topLeftCorner(nbs, nbs);
 
-        Tbsbs.noalias() = Sbsne * tr(barSbsne);
+        updateTbsbs(Sbsne, Hnene, barSbsne, Tbsbs);
 
         const auto Tbibi = Tbsbs.bottomRightCorner(nbi, nbi);
         const auto Tbibe = Tbsbs.bottomLeftCorner(nbi, nbe);
@@ -174,30 +262,57 @@ struct LinearSolverRangespace::Impl
         auto M43 = M4.middleCols(np + nbi, nbe);
         auto M44 = M4.rightCols(nni);
 
-        M11.noalias() = Vpp - Vpbe*barHbep - Vpne*barHnep + barVpne*tr(Sbine)*Hbip;
-        M12.noalias() = Vpbi + barVpne*tr(Sbine)*diag(Hbibi);
-        M13.noalias() = -barVpbe - barVpne*tr(Sbene);
+        Wpx.resize(np, nx);
+        auto barVpneSbine = Wpx.leftCols(nbi);
+
+        barVpneSbine.noalias() = barVpne*tr(Sbine);
+
+        M11 = Vpp;
+        M11.noalias() -= Vpbe*barHbep;
+        M11.noalias() -= Vpne*barHnep;
+        M11.noalias() += barVpneSbine*Hbip;
+        M12 = Vpbi;
+        M12.array() += barVpneSbine.array().rowwise() * tr(Hbibi).array();
+        M13 = -barVpbe;
+        M13.noalias() -= barVpne*tr(Sbene);
         M14.noalias() = Vpni;
 
-        M21.noalias() = Sbip - barSbine*Hnep + Tbibi*Hbip;
-        M22.noalias() = Ibibi + Tbibi*diag(Hbibi);
+        M21 = Sbip;
+        M21.noalias() -= barSbine*Hnep;
+        M21.noalias() += Tbibi*Hbip;
+        M22 = Tbibi.array().rowwise() * tr(Hbibi).array();
+        M22.diagonal().array() += 1.0;
         M23.noalias() = -Tbibe;
         M24.noalias() = Sbini;
 
-        M31.noalias() = Sbep - barHbep - barSbene*Hnep + Tbebi*Hbip;
-        M32.noalias() = Tbebi*diag(Hbibi);
-        M33 = diag(inv(-Hbebe)); M33 -= Tbebe;
+        M31 = Sbep - barHbep;
+        M31.noalias() -= barSbene*Hnep;
+        M31.noalias() += Tbebi*Hbip;
+        M32 = Tbebi.array().rowwise() * tr(Hbibi).array();
+        M33 = -Tbebe;
+        M33.diagonal().array() -= 1.0 / Hbebe.array();
         M34.noalias() = Sbeni;
 
-        M41.noalias() = Hnip - tr(Sbini)*Hbip;
-        M42.noalias() = -tr(Sbini)*diag(Hbibi);
+        M41 = Hnip;
+        M41.noalias() -= tr(Sbini)*Hbip;
+        M42 = -(tr(Sbini).array().rowwise() * tr(Hbibi).array());
         M43.noalias() = tr(Sbeni);
-        M44 = diag(Hnini);
+        M44.fill(0.0);
+        M44.diagonal() = Hnini;
 
+        // The dimension of M changes as variables become basic or non-basic
+        // and stable or unstable, so the workspace of the LU decomposition
+        // is allocated with the largest possible dimension of M
+        lu.reserve(nt);
         lu.decompose(M);
     }
 
     auto solve(CanonicalMatrix J, CanonicalVectorView a, CanonicalVectorRef u) -> void
+    {
+        solveMultiple(J, a, u);
+    }
+
+    auto solveMultiple(CanonicalMatrix J, CanonicalVectorsView a, CanonicalVectorsRef u) -> void
     {
         const auto dims = J.dims;
 
@@ -256,56 +371,84 @@ struct LinearSolverRangespace::Impl
         const auto Tbebi = Tbsbs.topRightCorner(nbe, nbi);
         const auto Tbebe = Tbsbs.topLeftCorner(nbe, nbe);
 
-        ax.resize(nx);
-        auto as  = ax.head(ns);
-        auto abs = as.head(nbs);
-        auto ans = as.tail(nns);
-        auto abe = abs.head(nbe);
-        auto ane = ans.head(nne);
-        auto abi = abs.tail(nbi);
-        auto ani = ans.tail(nni);
+        const auto k = a.xs.cols();
 
-        aw.resize(nw);
-        auto awbs = aw.head(nbs);
-        auto awbe = awbs.head(nbe);
-        auto awbi = awbs.tail(nbi);
+        ax.resize(nx, k);
+        auto as  = ax.topRows(ns);
+        auto abs = as.topRows(nbs);
+        auto ans = as.bottomRows(nns);
+        auto abe = abs.topRows(nbe);
+        auto ane = ans.topRows(nne);
+        auto abi = abs.bottomRows(nbi);
+        auto ani = ans.bottomRows(nni);
+
+        aw.resize(nw, k);
+        auto awbs = aw.topRows(nbs);
+        auto awbe = awbs.topRows(nbe);
+        auto awbi = awbs.bottomRows(nbi);
 
         as = a.xs;
         ap = a.p;
         awbs = a.wbs;
 
-        abe.noalias() = abe/Hbebe;
-        ane.noalias() = ane/Hnene;
+        abe.array().colwise() /= Hbebe.array();
+        ane.array().colwise() /= Hnene.array();
+
+        yw.resize(nx, k);
+        auto yne = yw.topRows(nne);
+
+        yne.noalias() = tr(Sbine)*abi;
+
+        ap.noalias() -= Vpbe*abe;
+        ap.noalias() -= Vpne*ane;
+        ap.noalias() += barVpne*yne;
+
+        awbi.noalias() -= Sbine*ane;
+        awbi.noalias() += Tbibi*abi;
+
+        awbe -= abe;
+        awbe.noalias() -= Sbene*ane;
+        awbe.noalias() += Tbebi*abi;
 
-        ap.noalias()   = ap - Vpbe*abe - Vpne*ane + barVpne*tr(Sbine)*abi;
-        awbi.noalias() = awbi - Sbine*ane + Tbibi*abi;
-        awbe.noalias() = awbe - abe - Sbene*ane + Tbebi*abi;
-        ani.noalias()  = ani - tr(Sbini)*abi;
+        ani.noalias() -= tr(Sbini)*abi;
 
         const auto t = np + nbi + nbe + nni;
 
-        rw.resize(nt);
-        sw.resize(nt);
+        rw.resize(nt, k);
+        sw.resize(nt, k);
 
-        auto r = rw.head(t);
-        auto s = sw.head(t);
+        auto r = rw.topRows(t);
+        auto s = sw.topRows(t);
 
-        auto p   = r.head(np);
-        auto xbi = r.segment(np, nbi);
-        auto wbe = r.segment(np + nbi, nbe);
-        auto xni = r.tail(nni);
+        auto p   = r.topRows(np);
+        auto xbi = r.middleRows(np, nbi);
+        auto wbe = r.middleRows(np + nbi, nbe);
+        auto xni = r.bottomRows(nni);
 
         r << ap, awbi, awbe, ani;
 
-        lu.solve(r);
+        lu.solveMultiple(r);
 
         auto wbi = awbi;
         auto xbe = abe;
         auto xne = ane;
 
-        wbi.noalias() = abi - Hbip*p - diag(Hbibi)*xbi;
-        xbe.noalias() = abe - (Hbep*p + wbe) / Hbebe;
-        xne.noalias() = ane - (Hnep*p + tr(Sbene)*wbe + tr(Sbine)*wbi) / Hnene;
+        auto ybe = yw.topRows(nbe);
+
+        wbi = abi;
+        wbi.noalias() -= Hbip*p;
+        wbi.array() -= xbi.array().colwise() * Hbibi.array();
+
+        ybe.noalias() = Hbep*p;
+        ybe += wbe;
+        ybe.array().colwise() /= Hbebe.array();
+        xbe -= ybe;
+
+        yne.noalias() = Hnep*p;
+        yne.noalias() += tr(Sbene)*wbe;
+        yne.noalias() += tr(Sbine)*wbi;
+        yne.array().colwise() /= Hnene.array();
+        xne -= yne;
 
         u.xs << xbe, xbi, xne, xni;
         u.p = p;
@@ -340,4 +483,9 @@ auto LinearSolverRangespace::solve(CanonicalMatrix J, CanonicalVectorView a, Can
     pimpl->solve(J, a, u);
 }
 
+auto LinearSolverRangespace::solveMultiple(CanonicalMatrix J, CanonicalVectorsView a, CanonicalVectorsRef u) -> void
+{
+    pimpl->solveMultiple(J, a, u);
+}
+
 } // namespace Optima
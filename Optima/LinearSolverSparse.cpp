@@ -0,0 +1,257 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "LinearSolverSparse.hpp"
+
+// C++ includes
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+// Eigen includes
+#include <Eigen/SparseLU>
+
+// Optima includes
+#include <Optima/CanonicalVector.hpp>
+#include <Optima/CanonicalMatrix.hpp>
+#include <Optima/Exception.hpp>
+#include <Optima/HeapAllocationGuard.hpp>
+#include <Optima/LinearSolverFullspace.hpp>
+
+namespace Optima {
+
+namespace {
+
+using SparseMatrix = Eigen::SparseMatrix<double>;
+using Triplet = Eigen::Triplet<double, SparseMatrix::StorageIndex>;
+
+} // namespace
+
+struct LinearSolverSparse::Impl
+{
+    //======================================================================
+    // Note: The matrix assembled here is the same as in
+    // LinearSolverFullspace, but only its non-zero entries are stored. The
+    // fill-reducing ordering of the sparse LU decomposition (the symbolic
+    // analysis) is computed only when the sparsity pattern of the matrix
+    // changes (e.g., because of a new partition of the variables). Otherwise,
+    // the new values are scattered into the existing pattern and only the
+    // numeric factorization is performed. Eigen's sparse LU decomposition
+    // allocates memory in its factorization and solution steps, which is
+    // why these are not subject to the heap allocation checks in the
+    // iterations of the optimization calculation.
+    //======================================================================
+
+    SparseMatrix mat;                ///< The sparse matrix assembled from the canonical matrix.
+    std::vector<Triplet> triplets;   ///< The non-zero entries of the canonical matrix used in its sparse assembly.
+    Eigen::SparseLU<SparseMatrix> lu; ///< The sparse LU decomposition solver.
+    Matrix rhs;                      ///< The matrix used as a workspace for the right-hand side vectors in the solve methods.
+    Matrix sol;                      ///< The matrix used as a workspace for the solution vectors in the solve methods.
+    bool analyzed = false;           ///< The flag that indicates if the symbolic analysis of the sparsity pattern of `mat` has been performed.
+    bool dense = false;              ///< The flag that indicates if the last decomposition failed and the dense solver was used instead.
+    LinearSolverFullspace fullspace; ///< The dense linear solver used when the sparse LU decomposition fails (e.g., for singular matrices).
+
+    Impl()
+    {}
+
+    Impl(const Impl& other)
+    : mat(other.mat), triplets(other.triplets), rhs(other.rhs), sol(other.sol),
+      analyzed(other.analyzed), dense(other.dense), fullspace(other.fullspace)
+    {
+        // The sparse LU decomposition is not copyable and needs to be recomputed
+        if(analyzed)
+        {
+            lu.analyzePattern(mat);
+            lu.factorize(mat);
+        }
+    }
+
+    /// Collect the non-zero entries of given matrix block positioned at given row and column.
+    auto collect(MatrixView B, Index row, Index col) -> void
+    {
+        for(Index j = 0; j < B.cols(); ++j)
+            for(Index i = 0; i < B.rows(); ++i)
+                if(B(i, j) != 0.0)
+                    triplets.emplace_back(row + i, col + j, B(i, j));
+    }
+
+    /// Collect the non-zero entries of the transpose of given matrix block positioned at given row and column.
+    auto collectTranspose(MatrixView B, Index row, Index col) -> void
+    {
+        for(Index i = 0; i < B.rows(); ++i)
+            for(Index j = 0; j < B.cols(); ++j)
+                if(B(i, j) != 0.0)
+                    triplets.emplace_back(row + j, col + i, B(i, j));
+    }
+
+    /// Collect the entries of an identity matrix block of given dimension positioned at given row and column.
+    auto collectIdentity(Index n, Index row, Index col) -> void
+    {
+        for(Index i = 0; i < n; ++i)
+            triplets.emplace_back(row + i, col + i, 1.0);
+    }
+
+    /// Scatter the collected entries into the existing sparsity pattern of `mat`.
+    /// @return False if some entry does not belong to the existing pattern.
+    auto scatter(Index t) -> bool
+    {
+        if(!analyzed || mat.rows() != t)
+            return false;
+
+        const auto outer = mat.outerIndexPtr();
+        const auto inner = mat.innerIndexPtr();
+        const auto values = mat.valuePtr();
+
+        std::fill(values, values + mat.nonZeros(), 0.0);
+
+        for(const auto& entry : triplets)
+        {
+            const auto begin = inner + outer[entry.col()];
+            const auto end = inner + outer[entry.col() + 1];
+            const auto pos = std::lower_bound(begin, end, entry.row());
+            if(pos == end || *pos != entry.row())
+                return false;
+            values[pos - inner] += entry.value();
+        }
+
+        return true;
+    }
+
+    auto decompose(CanonicalMatrix J) -> void
+    {
+        const HeapAllocationGuard guard(true);
+
+        const auto dims = J.dims;
+
+        const auto ns  = dims.ns;
+        const auto nbs = dims.nbs;
+        const auto np  = dims.np;
+
+        const auto t = ns + np + nbs;
+
+        dense = false;
+
+        if(t == 0)
+            return;
+
+        triplets.clear();
+
+        if(J.isHssDiag)
+            for(Index i = 0; i < ns; ++i)
+                triplets.emplace_back(i, i, J.Hss(i, i));
+        else collect(J.Hss, 0, 0);
+
+        collect(J.Hsp, 0, ns);
+        collect(J.Vps, ns, 0);
+        collect(J.Vpp, ns, ns);
+        collect(J.Sbsns, ns + np, nbs);
+        collect(J.Sbsp, ns + np, ns);
+        collectTranspose(J.Sbsns, nbs, ns + np);
+        collectIdentity(nbs, 0, ns + np);
+        collectIdentity(nbs, ns + np, 0);
+
+        if(!scatter(t))
+        {
+            mat.resize(t, t);
+            mat.setFromTriplets(triplets.begin(), triplets.end());
+            mat.makeCompressed();
+            lu.analyzePattern(mat);
+            analyzed = true;
+        }
+
+        lu.factorize(mat);
+
+        dense = lu.info() != Eigen::Success;
+
+        if(dense)
+            fullspace.decompose(J);
+    }
+
+    auto solve(CanonicalMatrix J, CanonicalVectorView a, CanonicalVectorRef u) -> void
+    {
+        solveMultiple(J, a, u);
+    }
+
+    auto solveMultiple(CanonicalMatrix J, CanonicalVectorsView a, CanonicalVectorsRef u) -> void
+    {
+        if(dense)
+            return fullspace.solveMultiple(J, a, u);
+
+        const HeapAllocationGuard guard(true);
+
+        const auto dims = J.dims;
+
+        const auto ns  = dims.ns;
+        const auto nbs = dims.nbs;
+        const auto nns = dims.nns;
+        const auto np  = dims.np;
+
+        const auto t = ns + np + nbs;
+        const auto k = a.xs.cols();
+
+        if(t == 0)
+            return;
+
+        rhs.resize(t, k);
+        rhs << a.xs, a.p, a.wbs;
+
+        sol = lu.solve(rhs);
+
+        const auto xbs = sol.topRows(nbs);
+        const auto xns = sol.middleRows(nbs, nns);
+        const auto p   = sol.middleRows(nbs + nns, np);
+        const auto wbs = sol.bottomRows(nbs);
+
+        u.xs << xbs, xns;
+        u.p = p;
+        u.wbs = wbs;
+    }
+};
+
+LinearSolverSparse::LinearSolverSparse()
+: pimpl(new Impl())
+{}
+
+LinearSolverSparse::LinearSolverSparse(const LinearSolverSparse& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+LinearSolverSparse::~LinearSolverSparse()
+{}
+
+auto LinearSolverSparse::operator=(LinearSolverSparse other) -> LinearSolverSparse&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto LinearSolverSparse::decompose(CanonicalMatrix M) -> void
+{
+    pimpl->decompose(M);
+}
+
+auto LinearSolverSparse::solve(CanonicalMatrix J, CanonicalVectorView a, CanonicalVectorRef u) -> void
+{
+    pimpl->solve(J, a, u);
+}
+
+auto LinearSolverSparse::solveMultiple(CanonicalMatrix J, CanonicalVectorsView a, CanonicalVectorsRef u) -> void
+{
+    pimpl->solveMultiple(J, a, u);
+}
+
+} // namespace Optima
@@ -21,6 +21,7 @@
 #include <Optima/Convergence.hpp>
 #include <Optima/ErrorControl.hpp>
 #include <Optima/Exception.hpp>
+#include <Optima/HeapAllocationGuard.hpp>
 #include <Optima/MasterProblem.hpp>
 #include <Optima/MasterVector.hpp>
 #include <Optima/NewtonStep.hpp>
@@ -30,6 +31,7 @@
 #include <Optima/ResidualFunction.hpp>
 #include <Optima/Result.hpp>
 #include <Optima/SensitivitySolver.hpp>
+#include <Optima/Timing.hpp>
 #include <Optima/TransformStep.hpp>
 
 namespace Optima {
@@ -51,6 +53,7 @@ struct MasterSolver::Impl
     Outputter outputter; ///< The object used to output the current state of the computation.
     Result result;
     Options options;
+    bool initialized = false; ///< The flag that indicates whether the structure of a master problem has been processed with initialize.
 
     Impl()
     {}
@@ -112,47 +115,95 @@ struct MasterSolver::Impl
         outputter.outputState();
     };
 
+    auto initialize(const MasterProblem& problem) -> void
+    {
+        initialized = false;
+        dims = problem.dims;
+        F.initialize(problem);
+        sensitivitysolver.initialize(problem);
+        initialized = true;
+    }
+
     auto solve(const MasterProblem& problem, MasterState& state) -> Result
+    {
+        Timer timer;
+        initialize(problem);
+        return iterate(problem, state, timer);
+    }
+
+    auto solve(const MasterProblem& problem, MasterState& state, MasterSensitivity& sensitity) -> Result
+    {
+        solve(problem, state);
+        return sensitivities(state, sensitity);
+    }
+
+    auto resolve(const MasterProblem& problem, MasterState& state) -> Result
+    {
+        errorif(!initialized, "Cannot solve the master optimization problem again with MasterSolver::resolve. "
+            "Call MasterSolver::initialize or MasterSolver::solve with this problem first.");
+        Timer timer;
+        F.reinitialize(problem);
+        return iterate(problem, state, timer);
+    }
+
+    auto resolve(const MasterProblem& problem, MasterState& state, MasterSensitivity& sensitity) -> Result
+    {
+        resolve(problem, state);
+        return sensitivities(state, sensitity);
+    }
+
+    auto iterate(const MasterProblem& problem, MasterState& state, const Timer& timer) -> Result
     {
         auto& u = state.u;
-        initialize(problem, u);
-        while(stepping(u))
+        initializeIterations(problem, u);
+        if(stepping(u))
+        {
+            // The first iteration initializes the workspace of the algorithm,
+            // after which no further heap allocation should be needed.
             step(u);
+            const HeapAllocationGuard guard(false);
+            while(stepping(u))
+                step(u);
+        }
         finalize(state);
+        result.time = timer.elapsed();
         return result;
     }
 
-    auto solve(const MasterProblem& problem, MasterState& state, MasterSensitivity& sensitity) -> Result
+    auto sensitivities(const MasterState& state, MasterSensitivity& sensitity) -> Result
     {
-        solve(problem, state);
-        F.updateOnlyJacobian(state.u); // update the Jacobian matrices wrt x, p, c
-        sensitivitysolver.solve(F, state, sensitity);
+        Timer timer;
+        {
+            const ScopedTimer sensitivitytimer(result.time_sensitivities);
+            F.updateOnlyJacobian(state.u); // update the Jacobian matrices wrt x, p, c
+            sensitivitysolver.solve(F, state, sensitity);
+        }
+        collectProfile();
+        result.time += timer.elapsed();
         return result;
     }
 
     auto setOptions(const Options& opts) -> void
     {
         options = opts;
+        F.setOptions(opts.residualfunction);
         newtonstep.setOptions(opts.newtonstep);
         convergence.setOptions(opts.convergence);
         outputter.setOptions(opts.output);
     }
 
-    auto initialize(const MasterProblem& problem, MasterVectorRef u) -> void
+    auto initializeIterations(const MasterProblem& problem, MasterVectorRef u) -> void
     {
         sanitycheck(problem, u);
-        dims = problem.dims;
         result = {};
         u.x.noalias() = min(max(u.x, problem.xlower), problem.xupper);
         u.p.noalias() = min(max(u.p, problem.plower), problem.pupper);
         uo = u;
-        F.initialize(problem);
         E.initialize(problem);
         transformstep.initialize(problem);
         newtonstep.initialize(problem);
         errorcontrol.initialize(problem);
         convergence.initialize(problem);
-        sensitivitysolver.initialize(problem);
         outputter.clear();
         outputHeaderTop();
     }
@@ -181,7 +232,10 @@ struct MasterSolver::Impl
     auto step(MasterVectorRef u) -> void
     {
         outputCurrentState();
-        newtonstep.apply(F, uo, u);
+        {
+            const ScopedTimer timer(result.time_linear_systems);
+            newtonstep.apply(F, uo, u);
+        }
         transformstep.execute(uo, u, F, E);
         errorcontrol.execute(uo, u, F, E);
         uo = u;
@@ -199,6 +253,29 @@ struct MasterSolver::Impl
         state.ju = ss.ju;
         state.jlu = ss.jlu;
         state.juu = ss.juu;
+        collectProfile();
+    }
+
+    auto collectProfile() -> void
+    {
+        if(!PROFILING) return;
+        const auto& profile = F.profile();
+        result.num_objective_evals     = profile.num_objective_evals;
+        result.num_objective_evals_f   = profile.num_objective_evals_f;
+        result.num_objective_evals_fx  = profile.num_objective_evals_fx;
+        result.num_objective_evals_fxx = profile.num_objective_evals_fxx;
+        result.num_objective_evals_fxp = profile.num_objective_evals_fxp;
+        result.num_constraint_evals_h  = profile.num_constraint_evals_h;
+        result.num_constraint_evals_hx = profile.num_constraint_evals_hx;
+        result.num_constraint_evals_hp = profile.num_constraint_evals_hp;
+        result.num_constraint_evals_v  = profile.num_constraint_evals_v;
+        result.num_constraint_evals_vx = profile.num_constraint_evals_vx;
+        result.num_constraint_evals_vp = profile.num_constraint_evals_vp;
+        result.time_objective_evals    = profile.time_objective_evals;
+        result.time_constraint_evals   = profile.time_constraint_evals;
+        result.time_echelonization     = profile.time_echelonization;
+        result.time_stability          = profile.time_stability;
+        result.time_canonicalization   = profile.time_canonicalization;
     }
 
     auto sanitycheck(const MasterProblem& problem, MasterVectorRef u) -> void
@@ -238,6 +315,11 @@ auto MasterSolver::setOptions(const Options& options) -> void
     pimpl->setOptions(options);
 }
 
+auto MasterSolver::initialize(const MasterProblem& problem) -> void
+{
+    pimpl->initialize(problem);
+}
+
 auto MasterSolver::solve(const MasterProblem& problem, MasterState& state) -> Result
 {
     return pimpl->solve(problem, state);
@@ -248,4 +330,14 @@ auto MasterSolver::solve(const MasterProblem& problem, MasterState& state, Maste
     return pimpl->solve(problem, state, sensitivity);
 }
 
+auto MasterSolver::resolve(const MasterProblem& problem, MasterState& state) -> Result
+{
+    return pimpl->resolve(problem, state);
+}
+
+auto MasterSolver::resolve(const MasterProblem& problem, MasterState& state, MasterSensitivity& sensitivity) -> Result
+{
+    return pimpl->resolve(problem, state, sensitivity);
+}
+
 } // namespace Optima
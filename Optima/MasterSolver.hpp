@@ -54,11 +54,28 @@ public:
     /// Set the options for the master optimization calculation.
     auto setOptions(const Options& options) -> void;
 
+    /// Initialize this solver with the structure of a master optimization problem.
+    /// This processes the dimensions, the functions and the matrices *Ax*,
+    /// *Ap* and *bc* of the problem, which includes the echelonization of *Ax*
+    /// and *Ap*. It is performed by @ref solve, but not by @ref resolve.
+    auto initialize(const MasterProblem& problem) -> void;
+
     /// Solve the given master optimization problem.
     auto solve(const MasterProblem& problem, MasterState& state) -> Result;
 
     /// Solve the given master optimization problem and compute the sensitivity derivatives at the end.
     auto solve(const MasterProblem& problem, MasterState& state, MasterSensitivity& sensitivity) -> Result;
+
+    /// Solve the master optimization problem given in the last call to @ref initialize or @ref solve.
+    /// Only the vectors *b*, *c*, *xlower*, *xupper*, *plower* and *pupper* of
+    /// the given problem are used, which may have changed since then. Its
+    /// functions and matrices are assumed unchanged and are not processed
+    /// again, so that the echelonization of *Ax* and *Ap* is skipped.
+    auto resolve(const MasterProblem& problem, MasterState& state) -> Result;
+
+    /// Solve the master optimization problem given in the last call to @ref initialize or @ref solve and compute the sensitivity derivatives at the end.
+    /// @see resolve(const MasterProblem&, MasterState&)
+    auto resolve(const MasterProblem& problem, MasterState& state, MasterSensitivity& sensitivity) -> Result;
 };
 
 } // namespace Optima
@@ -30,6 +30,12 @@ using MasterVector     = MasterVectorBase<Vector>;
 using MasterVectorRef  = MasterVectorBase<VectorRef>;
 using MasterVectorView = MasterVectorBase<VectorView>;
 
+/// Used to represent master vectors stored column-wise (e.g., the right-hand sides in linear solves with multiple right-hand sides).
+using MasterVectorsRef  = MasterVectorBase<MatrixRef>;
+
+/// Used to represent immutable master vectors stored column-wise (e.g., the right-hand sides in linear solves with multiple right-hand sides).
+using MasterVectorsView = MasterVectorBase<MatrixView>;
+
 /// Used as a base template type for master vector types.
 template<typename Vec>
 struct MasterVectorBase
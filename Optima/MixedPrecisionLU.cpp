@@ -0,0 +1,303 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#include "MixedPrecisionLU.hpp"
+
+// C++ includes
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+// Optima includes
+#include <Optima/LU.hpp>
+#include <Optima/Utils.hpp>
+
+namespace Optima {
+
+struct MixedPrecisionLU::Impl
+{
+    //======================================================================
+    // Note: The refinement below follows LAPACK's dsgesv. The matrix is
+    // decomposed in single precision with blocked partial pivoting, which
+    // requires about half of the time of the double-precision decomposition
+    // (twice as many entries per SIMD register and half of the memory
+    // traffic). Each solution x is then refined with corrections computed
+    // with the single-precision factors from the residual r = b - A*x, which
+    // is computed in double precision with a copy of the matrix. This costs
+    // O(n^2) per refinement step, and converges to a double-precision
+    // solution in a few steps when the condition number of the matrix is
+    // well below 1/eps(float) ~ 1e7. The solution is accepted when:
+    //
+    //   norminf(r) <= sqrt(n) * eps(double) * norminf(A) * norminf(x),
+    //
+    // for every right-hand side. If the residual does not decrease at least
+    // by half in a refinement step (e.g., the matrix is singular or too
+    // ill-conditioned), the matrix is decomposed with class LU, which can
+    // also deal with singular matrices, and the linear systems are solved
+    // again with it. As in class LU, the workspace matrices never shrink,
+    // and they can be allocated beforehand for the largest dimension of the
+    // matrices to be decomposed (see method reserve), including the workspace
+    // of the double-precision decomposition.
+    //======================================================================
+
+    /// The maximum number of refinement steps before the double-precision LU decomposition is used.
+    static constexpr Index maxiters = 30;
+
+    /// The workspace whose top-left corner contains the single-precision LU factors of the last decomposed matrix.
+    MatrixXf LUw;
+
+    /// The row transpositions applied during the decomposition, which result in the permutation matrix P in P*A = L*U.
+    Indices ptr;
+
+    /// The workspace whose top-left corner contains a copy of the last decomposed matrix, used to compute the residuals.
+    Matrix Aw;
+
+    /// The workspace for the right-hand side vectors.
+    Matrix Bw;
+
+    /// The workspace for the residual vectors.
+    Matrix Rw;
+
+    /// The workspace for the single-precision residual vectors and corrections.
+    MatrixXf Fw;
+
+    /// The double-precision LU decomposition used when the refinement stalls.
+    LU lu;
+
+    /// The dimension of the last decomposed matrix.
+    Index n = 0;
+
+    /// The infinity norm of the last decomposed matrix.
+    double Anorm = 0.0;
+
+    /// The flag that indicates if the last decomposed matrix is solved with the double-precision LU decomposition.
+    bool fallback = false;
+
+    /// Construct a default Impl object.
+    Impl()
+    {}
+
+    /// Return true if empty.
+    auto empty() const -> bool
+    {
+        return n == 0;
+    }
+
+    /// Allocate the workspace for the decomposition of matrices with dimension up to a given one.
+    auto reserve(Index m) -> void
+    {
+        ensureMinimumDimension(LUw, m, m);
+        ensureMinimumDimension(Aw, m, m);
+        ensureMinimumDimension(ptr, m);
+        ensureMinimumDimension(Bw, m, 1);
+        ensureMinimumDimension(Rw, m, 1);
+        ensureMinimumDimension(Fw, m, 1);
+        lu.reserve(m);
+    }
+
+    /// Compute the single-precision LU decomposition of the given matrix.
+    auto decompose(MatrixView A) -> void
+    {
+        assert(A.rows() == A.cols());
+
+        using PartialPivLUImpl = Eigen::internal::partial_lu_impl<float, Eigen::ColMajor, Index>;
+
+        n = A.rows();
+
+        reserve(n);
+
+        fallback = false;
+
+        if(n == 0)
+            return;
+
+        auto M = LUw.topLeftCorner(n, n);
+
+        Aw.topLeftCorner(n, n) = A;
+        M = A.cast<float>();
+
+        Anorm = A.cwiseAbs().rowwise().sum().maxCoeff();
+
+        Index nswaps = 0;
+        const auto zeropivot = PartialPivLUImpl::blocked_lu(n, n, M.data(), M.outerStride(), ptr.data(), nswaps);
+
+        if(zeropivot >= 0 || !std::isfinite(Anorm) || Anorm > std::numeric_limits<float>::max())
+            decomposeDouble();
+    }
+
+    /// Decompose the last decomposed matrix with the double-precision LU decomposition.
+    auto decomposeDouble() -> void
+    {
+        lu.decompose(Aw.topLeftCorner(n, n));
+        fallback = true;
+    }
+
+    /// Solve the linear systems `A*X = B` in-place with the single-precision LU factors.
+    auto solveSingle(MatrixRef X) -> void
+    {
+        const auto M = LUw.topLeftCorner(n, n);
+
+        auto F = Fw.topLeftCorner(n, X.cols());
+
+        F = X.cast<float>();
+
+        for(Index k = 0; k < n; ++k)
+            if(ptr[k] != k) F.row(k).swap(F.row(ptr[k]));
+
+        M.triangularView<Eigen::UnitLower>().solveInPlace(F);
+        M.triangularView<Eigen::Upper>().solveInPlace(F);
+
+        X = F.cast<double>();
+    }
+
+    /// Return the largest ratio among the columns of the residual norms to their accepted values.
+    auto residualRatio(MatrixView X, MatrixView R) const -> double
+    {
+        const auto eps = std::numeric_limits<double>::epsilon();
+        const auto cte = std::sqrt(static_cast<double>(n)) * eps * Anorm;
+
+        auto ratio = 0.0;
+        for(Index j = 0; j < X.cols(); ++j)
+        {
+            const auto rnorm = R.col(j).lpNorm<Eigen::Infinity>();
+            if(rnorm == 0.0)
+                continue;
+            const auto current = rnorm / (cte * X.col(j).lpNorm<Eigen::Infinity>());
+            if(!(current <= ratio))
+                ratio = current; // also propagates NaN, which stops the refinement
+            if(std::isnan(ratio))
+                break;
+        }
+
+        return ratio;
+    }
+
+    /// Solve the linear systems `A*X = B` using the LU decomposition obtained with @ref decompose.
+    auto solveMultiple(MatrixRef X) -> void
+    {
+        assert(n == X.rows());
+
+        const auto k = X.cols();
+
+        if(n == 0 || k == 0)
+            return;
+
+        if(fallback)
+            return lu.solveMultiple(X);
+
+        ensureMinimumDimension(Bw, n, k);
+        ensureMinimumDimension(Rw, n, k);
+        ensureMinimumDimension(Fw, n, k);
+
+        const auto A = Aw.topLeftCorner(n, n);
+
+        auto B = Bw.topLeftCorner(n, k);
+        auto R = Rw.topLeftCorner(n, k);
+
+        B = X;
+
+        solveSingle(X);
+
+        auto previous = std::numeric_limits<double>::infinity();
+
+        for(Index i = 0; i <= maxiters; ++i)
+        {
+            R = B;
+            R.noalias() -= A * X;
+
+            const auto ratio = residualRatio(X, R);
+
+            if(ratio <= 1.0)
+                return;
+
+            if(i == maxiters || !(ratio <= 0.5 * previous))
+                break; // the refinement has stalled
+
+            previous = ratio;
+
+            solveSingle(R);
+
+            X += R;
+        }
+
+        decomposeDouble();
+
+        X = B;
+        lu.solveMultiple(X);
+    }
+};
+
+MixedPrecisionLU::MixedPrecisionLU()
+: pimpl(new Impl())
+{}
+
+MixedPrecisionLU::MixedPrecisionLU(const MixedPrecisionLU& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+MixedPrecisionLU::~MixedPrecisionLU()
+{}
+
+auto MixedPrecisionLU::operator=(MixedPrecisionLU other) -> MixedPrecisionLU&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto MixedPrecisionLU::empty() const -> bool
+{
+    return pimpl->empty();
+}
+
+auto MixedPrecisionLU::reserve(Index n) -> void
+{
+    pimpl->reserve(n);
+}
+
+auto MixedPrecisionLU::decompose(MatrixView A) -> void
+{
+    pimpl->decompose(A);
+}
+
+auto MixedPrecisionLU::solve(VectorView b, VectorRef x) -> void
+{
+    x = b;
+    pimpl->solveMultiple(x);
+}
+
+auto MixedPrecisionLU::solve(VectorRef x) -> void
+{
+    pimpl->solveMultiple(x);
+}
+
+auto MixedPrecisionLU::solveMultiple(MatrixView B, MatrixRef X) -> void
+{
+    X = B;
+    pimpl->solveMultiple(X);
+}
+
+auto MixedPrecisionLU::solveMultiple(MatrixRef X) -> void
+{
+    pimpl->solveMultiple(X);
+}
+
+auto MixedPrecisionLU::fallback() const -> bool
+{
+    return pimpl->fallback;
+}
+
+} // namespace Optima
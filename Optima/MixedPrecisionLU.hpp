@@ -0,0 +1,90 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/Index.hpp>
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+/// A class for the solution of linear systems using a single-precision LU decomposition with iterative refinement.
+/// The matrix is decomposed in single precision with partial pivoting, and
+/// the solutions are refined with residuals computed in double precision
+/// until they are as accurate as those of a double-precision decomposition.
+/// If the refinement stalls (e.g., because the matrix is singular or too
+/// ill-conditioned for single precision), the matrix is decomposed with
+/// class LU instead, which is then used until the next decomposition.
+struct MixedPrecisionLU
+{
+    /// Construct a default MixedPrecisionLU object.
+    MixedPrecisionLU();
+
+    /// Construct a copy of a MixedPrecisionLU object.
+    MixedPrecisionLU(const MixedPrecisionLU& other);
+
+    /// Destroy this MixedPrecisionLU object.
+    virtual ~MixedPrecisionLU();
+
+    /// Assign a MixedPrecisionLU object to this.
+    auto operator=(MixedPrecisionLU other) -> MixedPrecisionLU&;
+
+    /// Return true if empty.
+    auto empty() const -> bool;
+
+    /// Allocate the workspace for the decomposition of matrices with dimension up to a given one.
+    /// This includes the workspace of the double-precision LU decomposition
+    /// used when the refinement stalls, so that no heap allocation happens
+    /// when matrices of varying dimensions are decomposed in sequence, even
+    /// if the refinement stalls (see HeapAllocationGuard).
+    auto reserve(Index n) -> void;
+
+    /// Compute the single-precision LU decomposition of the given matrix.
+    auto decompose(MatrixView A) -> void;
+
+    /// Solve the linear system `A*x = b` using the LU decomposition obtained with @ref decompose.
+    /// @note Ensure method @ref decompose has been called before this method.
+    auto solve(VectorView b, VectorRef x) -> void;
+
+    /// Solve the linear system `A*x = b` using the LU decomposition obtained with @ref decompose.
+    /// @param[in,out] x As input, vector `b`. As output, vector `x`.
+    /// @note Ensure method @ref decompose has been called before this method.
+    auto solve(VectorRef x) -> void;
+
+    /// Solve the linear systems `A*X = B` with multiple right-hand sides using the LU decomposition obtained with @ref decompose.
+    /// @note Ensure method @ref decompose has been called before this method.
+    auto solveMultiple(MatrixView B, MatrixRef X) -> void;
+
+    /// Solve the linear systems `A*X = B` with multiple right-hand sides using the LU decomposition obtained with @ref decompose.
+    /// @param[in,out] X As input, matrix `B`. As output, matrix `X`.
+    /// @note Ensure method @ref decompose has been called before this method.
+    auto solveMultiple(MatrixRef X) -> void;
+
+    /// Return true if the last decomposed matrix is solved with the double-precision LU decomposition because the refinement stalled.
+    auto fallback() const -> bool;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
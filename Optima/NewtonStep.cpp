@@ -33,12 +33,25 @@ struct NewtonStep::Impl
     Vector plower;             ///< The lower bounds for variables *p*.
     Vector pupper;             ///< The upper bounds for variables *p*.
 
+    SimplifiedNewtonOptions simplified; ///< The options for the simplified Newton method.
+    bool decomposed = false;            ///< True if the linear solver holds a decomposition of the Jacobian matrix.
+    unsigned reuses = 0;                ///< The number of consecutive iterations in which the current decomposition has been reused.
+    double error = 0.0;                 ///< The residual error in the previous Newton step.
+    Indices jb;                         ///< The indices of the basic variables when the current decomposition was computed (with capacity *nx*).
+    Indices js;                         ///< The indices of the stable variables when the current decomposition was computed (with capacity *nx*).
+    Index nb = 0;                       ///< The number of basic variables when the current decomposition was computed.
+    Index ns = 0;                       ///< The number of stable variables when the current decomposition was computed.
+    Index nbe = 0;                      ///< The number of explicit basic stable variables when the current decomposition was computed.
+    Index nne = 0;                      ///< The number of explicit non-basic stable variables when the current decomposition was computed.
+
     Impl()
     {}
 
     auto setOptions(const NewtonStepOptions options) -> void
     {
         linearsolver.setOptions(options.linearsolver);
+        simplified = options.simplified;
+        decomposed = false;
     }
 
     auto initialize(const MasterProblem& problem) -> void
@@ -49,6 +62,11 @@ struct NewtonStep::Impl
         plower = problem.plower;
         pupper = problem.pupper;
         du.resize(dims);
+        jb.resize(dims.nx);
+        js.resize(dims.nx);
+        decomposed = false;
+        reuses = 0;
+        error = 0.0;
     }
 
     auto apply(const ResidualFunction& F, MasterVectorView uo, MasterVectorRef u) -> void
@@ -57,8 +75,15 @@ struct NewtonStep::Impl
         const auto res = F.result();
         const auto Jc = res.Jc;
         const auto Fc = res.Fc;
-        linearsolver.decompose(Jc);
-        linearsolver.solve(Jc, Fc, du);
+        const auto err = residualError(Fc);
+        const auto reuse = reusable(Jc, err);
+        if(reuse)
+            reuses += 1;
+        else decompose(Jc);
+        error = err;
+        if(reuse)
+            linearsolver.solveWithPreviousDecomposition(Jc, Fc, du);
+        else linearsolver.solve(Jc, Fc, du);
         u.x.noalias() = uo.x + du.x;
         u.p.noalias() = uo.p + du.p;
         u.w.noalias() = uo.w + du.w;
@@ -66,6 +91,43 @@ struct NewtonStep::Impl
         u.p.noalias() = min(max(u.p, plower), pupper);
     }
 
+    auto decompose(CanonicalMatrix Jc) -> void
+    {
+        linearsolver.decompose(Jc);
+        decomposed = true;
+        reuses = 0;
+        nb = Jc.jb.size();
+        ns = Jc.js.size();
+        nbe = Jc.dims.nbe;
+        nne = Jc.dims.nne;
+        jb.head(nb) = Jc.jb;
+        js.head(ns) = Jc.js;
+    }
+
+    /// Return true if the current decomposition of the Jacobian matrix can be used for the Newton step with given residual error.
+    auto reusable(CanonicalMatrix Jc, double err) const -> bool
+    {
+        if(!simplified.active || !decomposed)
+            return false;
+        if(reuses >= simplified.maxreuses)
+            return false;
+        if(!(err <= simplified.contraction * error))
+            return false; // the convergence is not fast enough (e.g., far from the solution or the reused decomposition is too inaccurate)
+        if(Jc.jb.size() != nb || Jc.js.size() != ns || Jc.dims.nbe != nbe || Jc.dims.nne != nne)
+            return false;
+        return Jc.jb == jb.head(nb) && Jc.js == js.head(ns); // the canonical form, and so the factorized matrix, depends on the basic and stable variables and their ordering
+    }
+
+    /// Return the residual error used to monitor the contraction of the simplified Newton iterations.
+    static auto residualError(CanonicalVectorView Fc) -> double
+    {
+        auto err = 0.0;
+        if(Fc.xs.size()) err = std::max(err, Fc.xs.lpNorm<Eigen::Infinity>());
+        if(Fc.p.size()) err = std::max(err, Fc.p.lpNorm<Eigen::Infinity>());
+        if(Fc.wbs.size()) err = std::max(err, Fc.wbs.lpNorm<Eigen::Infinity>());
+        return err;
+    }
+
     auto sanitycheck() const -> void
     {
         assert(xlower.size() == dims.nx);
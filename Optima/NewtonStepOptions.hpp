@@ -22,11 +22,33 @@
 
 namespace Optima {
 
+/// The options for the simplified Newton method, in which the decomposition of the Jacobian matrix is reused across iterations.
+struct SimplifiedNewtonOptions
+{
+    /// True if the decomposition of the Jacobian matrix in a previous iteration can be reused.
+    /// The decomposition is reused only if the basic and stable variables
+    /// have not changed since it was computed and the residual error has
+    /// decreased by at least the factor @ref contraction in the last
+    /// iteration. The Newton step is then computed with the factors of the
+    /// previous Jacobian matrix, which avoids its decomposition when the
+    /// iterations are close to the solution.
+    bool active = false;
+
+    /// The maximum ratio between the current and the previous residual errors for which a decomposition is reused.
+    double contraction = 0.5;
+
+    /// The maximum number of consecutive iterations in which a decomposition is reused.
+    unsigned maxreuses = 5;
+};
+
 /// The options used for Newton step calculations in NewtonStep.
 struct NewtonStepOptions
 {
     /// The options for the linear solver.
     LinearSolverOptions linearsolver;
+
+    /// The options for the simplified Newton method.
+    SimplifiedNewtonOptions simplified;
 };
 
 } // namespace Optima
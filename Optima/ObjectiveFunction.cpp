@@ -19,6 +19,7 @@
 
 // Optima includes
 #include <Optima/Exception.hpp>
+#include <Optima/HeapAllocationGuard.hpp>
 
 namespace Optima {
 
@@ -56,6 +57,10 @@ auto ObjectiveFunction::operator()(ObjectiveResultRef res, VectorView x, VectorV
     res.diagfxx = false;
     res.fxx4basicvars = false;
     res.succeeded = true;
+
+    // Heap allocations are allowed in the evaluation of the user function
+    const HeapAllocationGuard guard(true);
+
     fn(res, x, p, c, opts);
 }
 
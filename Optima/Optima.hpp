@@ -18,6 +18,7 @@
 #pragma once
 
 // Optima includes
+#include <Optima/BatchSolver.hpp>
 #include <Optima/CanonicalDims.hpp>
 #include <Optima/Canonicalizer.hpp>
 #include <Optima/CanonicalMatrix.hpp>
@@ -30,13 +31,16 @@
 #include <Optima/Exception.hpp>
 #include <Optima/Index.hpp>
 #include <Optima/LinearSolver.hpp>
+#include <Optima/LDLT.hpp>
 #include <Optima/LU.hpp>
 #include <Optima/Matrix.hpp>
+#include <Optima/MixedPrecisionLU.hpp>
 #include <Optima/ObjectiveFunction.hpp>
 #include <Optima/Options.hpp>
 #include <Optima/Problem.hpp>
 #include <Optima/Result.hpp>
 #include <Optima/Solver.hpp>
+#include <Optima/SolverSession.hpp>
 #include <Optima/Stability.hpp>
 #include <Optima/State.hpp>
 #include <Optima/Timing.hpp>
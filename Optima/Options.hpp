@@ -27,6 +27,7 @@
 #include <Optima/LinearSolverOptions.hpp>
 #include <Optima/NewtonStepOptions.hpp>
 #include <Optima/OutputterOptions.hpp>
+#include <Optima/ResidualFunctionOptions.hpp>
 #include <Optima/TransformFunction.hpp>
 
 namespace Optima {
@@ -120,6 +121,9 @@ public:
     /// The options used for Newton step calculations.
     NewtonStepOptions newtonstep;
 
+    /// The options used for the evaluation of the residual function.
+    ResidualFunctionOptions residualfunction;
+
     /// The options used for convergence analysis.
     ConvergenceOptions convergence;
 };
@@ -17,6 +17,9 @@
 
 #include "ResidualFunction.hpp"
 
+// C++ includes
+#include <cmath>
+
 // Optima includes
 #include <Optima/Canonicalizer.hpp>
 #include <Optima/EchelonizerW.hpp>
@@ -81,6 +84,41 @@ struct ResidualFunction::Impl
     /// True if the last update call succeeded.
     bool succeeded = false;
 
+    /// The evaluation counters and wall times accumulated since initialization.
+    ResidualFunctionProfile profile;
+
+    /// The options for the evaluation of the residual function.
+    ResidualFunctionOptions options;
+
+    /// The quasi-Newton approximation of the Hessian matrix *fxx* (if HessianMethod::QuasiNewton is used).
+    Matrix Bxx;
+
+    /// The vectors *x* and *fx* in the previous evaluation used for the quasi-Newton updates.
+    Vector xprev, fxprev;
+
+    /// The workspace vectors *s = x - xprev*, *y = fx - fxprev* and *Bxx·s* for the quasi-Newton updates.
+    Vector qs, qy, qBs;
+
+    /// The number of quasi-Newton updates applied to `Bxx` since initialization (-1 if `Bxx` has not been started yet).
+    Index qnupdates = -1;
+
+    /// The residual errors in the last and the previous evaluations used to decide when `Bxx` is restarted from the exact *fxx*.
+    double qnerror = infinity(), qnerrorprev = infinity();
+
+    //======================================================================
+    // Note: The objective functions of interest often have curvatures that
+    // change by many orders of magnitude along the iterations (e.g., the
+    // terms x*ln(x) in Gibbs energy functions, whose curvature 1/x becomes
+    // very large as x approaches its lower bound). The BFGS updates recover
+    // such changes only slowly, so that, without a line search, the Newton
+    // steps with Bxx can overshoot or become too short for many iterations.
+    // Thus, if the exact fxx can be evaluated (see hessianexactfirst), Bxx is
+    // restarted from the exact fxx whenever the residual error has not
+    // decreased by at least the factor hessiancontraction in the last
+    // evaluation. In the worst case, fxx is evaluated in every iteration, as
+    // with HessianMethod::Exact.
+    //======================================================================
+
     Impl()
     {}
 
@@ -99,10 +137,41 @@ struct ResidualFunction::Impl
         f = problem.f;
         h = problem.h;
         v = problem.v;
+        initializeVectors(problem);
+    }
+
+    auto reinitialize(const MasterProblem& problem) -> void
+    {
+        errorif(problem.dims.nx != dims.nx || problem.dims.np != dims.np || problem.dims.ny != dims.ny || problem.dims.nz != dims.nz,
+            "Cannot reinitialize the residual function with a master problem whose dimensions differ from those in the last initialization.");
+        errorif(problem.c.size() != c.size(),
+            "Cannot reinitialize the residual function with a master problem whose vector c has size ", problem.c.size(), " instead of ", c.size(), ".");
+        echelonizerW.reset();
+        initializeVectors(problem);
+    }
+
+    auto initializeVectors(const MasterProblem& problem) -> void
+    {
         b = problem.b;
         xlower = problem.xlower;
         xupper = problem.xupper;
         c = problem.c;
+        profile = {};
+        initializeQuasiNewton(dims.nx);
+    }
+
+    auto initializeQuasiNewton(Index nx) -> void
+    {
+        qnupdates = -1;
+        qnerror = qnerrorprev = infinity();
+        if(options.hessian != HessianMethod::QuasiNewton)
+            return;
+        Bxx.resize(nx, nx);
+        xprev.resize(nx);
+        fxprev.resize(nx);
+        qs.resize(nx);
+        qy.resize(nx);
+        qBs.resize(nx);
     }
 
     auto update(MasterVectorView u) -> void
@@ -144,15 +213,112 @@ struct ResidualFunction::Impl
         const auto nc = c.size();
         const auto RWQ = echelonizerW.RWQ();
         const auto ibasicvars = RWQ.jb;
-        ObjectiveOptions  fopts{{eval_ddx, eval_ddp && np, eval_ddc && nc}, ibasicvars};
+        const auto quasinewton = eval_ddx && !eval_ddc && options.hessian == HessianMethod::QuasiNewton; // sensitivity derivatives always need exact fxx
+        if(quasinewton && qnupdates != -1 && options.hessianexactfirst && !(qnerror <= options.hessiancontraction * qnerrorprev))
+        {
+            qnupdates = -1; // restart Bxx from the exact fxx since the iterations are not converging fast enough
+            qnerror = infinity(); // so that Bxx is kept in the next iteration
+        }
+        const auto eval_fxx = eval_ddx && (!quasinewton || (qnupdates == -1 && options.hessianexactfirst));
+        ObjectiveOptions  fopts{{eval_fxx, eval_ddp && np, eval_ddc && nc}, ibasicvars};
         ConstraintOptions hopts{{eval_ddx, eval_ddp && np, eval_ddc && nc}, ibasicvars};
         ConstraintOptions vopts{{eval_ddx, eval_ddp && np, eval_ddc && nc}, ibasicvars};
-        f(fres, x, p, c, fopts);
-        if(nz) h(hres, x, p, c, hopts);
-        if(np) v(vres, x, p, c, vopts);
+        evaluateObjectiveFunction(x, p, fopts);
+        if(quasinewton) updateQuasiNewtonHessian(x, eval_fxx);
+        if(nz) evaluateConstraintFunctionH(x, p, hopts);
+        if(np) evaluateConstraintFunctionV(x, p, vopts);
         return succeeded = fres.succeeded && hres.succeeded && vres.succeeded;
     }
 
+    auto evaluateObjectiveFunction(VectorView x, VectorView p, const ObjectiveOptions& opts) -> void
+    {
+        const ScopedTimer timer(profile.time_objective_evals);
+        f(fres, x, p, c, opts);
+        if(PROFILING)
+        {
+            profile.num_objective_evals += 1;
+            profile.num_objective_evals_f += 1; // f and fx are requested in every evaluation (there are no flags for them in opts.eval)
+            profile.num_objective_evals_fx += 1;
+            profile.num_objective_evals_fxx += opts.eval.fxx;
+            profile.num_objective_evals_fxp += opts.eval.fxp;
+        }
+    }
+
+    /// Update the quasi-Newton approximation `Bxx` with the damped BFGS formula and use it as *fxx*.
+    auto updateQuasiNewtonHessian(VectorView x, bool exactfxx) -> void
+    {
+        const auto& fx = fres.fx;
+
+        if(!fres.succeeded)
+            return;
+
+        if(qnupdates == -1)
+        {
+            if(exactfxx && fres.diagfxx)
+            {
+                Bxx.setZero();
+                Bxx.diagonal() = fres.fxx.diagonal();
+            }
+            else if(exactfxx) Bxx = fres.fxx;
+            else Bxx.setIdentity();
+            qnupdates = 0;
+        }
+        else
+        {
+            qs.noalias() = x - xprev;
+            qy.noalias() = fx - fxprev;
+            const auto sy = qs.dot(qy);
+            if(qnupdates == 0 && !options.hessianexactfirst && sy > 0.0)
+                Bxx.diagonal().setConstant(qy.squaredNorm()/sy); // the scaled identity in the first update (see Nocedal and Wright, 2006, eq. 6.20)
+            qBs.noalias() = Bxx * qs;
+            const auto sBs = qs.dot(qBs);
+            if(sBs > 0.0 && std::isfinite(sy)) // skip the update if s = 0 (e.g., the same x is evaluated again)
+            {
+                // Powell's damping keeps Bxx positive definite even if the curvature condition s'y > 0 fails
+                const auto theta = (sy >= 0.2*sBs) ? 1.0 : 0.8*sBs/(sBs - sy);
+                qy *= theta;
+                qy.noalias() += (1.0 - theta) * qBs; // qy = r = theta*y + (1 - theta)*Bs, for which s'r >= 0.2*s'Bs > 0
+                const auto sr = qs.dot(qy);
+                qBs /= std::sqrt(sBs);
+                qy /= std::sqrt(sr);
+                Bxx.noalias() -= qBs * qBs.transpose();
+                Bxx.noalias() += qy * qy.transpose();
+                ++qnupdates;
+            }
+        }
+
+        xprev.noalias() = x;
+        fxprev.noalias() = fx;
+
+        fres.fxx = Bxx;
+        fres.diagfxx = false;
+        fres.fxx4basicvars = false;
+    }
+
+    auto evaluateConstraintFunctionH(VectorView x, VectorView p, const ConstraintOptions& opts) -> void
+    {
+        const ScopedTimer timer(profile.time_constraint_evals);
+        h(hres, x, p, c, opts);
+        if(PROFILING)
+        {
+            profile.num_constraint_evals_h += 1;
+            profile.num_constraint_evals_hx += opts.eval.ddx;
+            profile.num_constraint_evals_hp += opts.eval.ddp;
+        }
+    }
+
+    auto evaluateConstraintFunctionV(VectorView x, VectorView p, const ConstraintOptions& opts) -> void
+    {
+        const ScopedTimer timer(profile.time_constraint_evals);
+        v(vres, x, p, c, opts);
+        if(PROFILING)
+        {
+            profile.num_constraint_evals_v += 1;
+            profile.num_constraint_evals_vx += opts.eval.ddx;
+            profile.num_constraint_evals_vp += opts.eval.ddp;
+        }
+    }
+
     auto updateFunctionEvals(MasterVectorView u) -> bool
     {
         bool ddx = true, ddp = true, ddc = false;
@@ -173,6 +339,7 @@ struct ResidualFunction::Impl
 
     auto updateEchelonFormMatrixW(MasterVectorView u) -> void
     {
+        const ScopedTimer timer(profile.time_echelonization);
         const auto& x = u.x;
         const auto& Jx = hres.ddx;
         const auto& Jp = hres.ddp;
@@ -185,6 +352,7 @@ struct ResidualFunction::Impl
 
     auto updateIndicesStableVariables(MasterVectorView u) -> void
     {
+        const ScopedTimer timer(profile.time_stability);
         const auto& fx = fres.fx;
         const auto& x = u.x;
         const auto& w = u.w;
@@ -195,6 +363,7 @@ struct ResidualFunction::Impl
 
     auto updateCanonicalFormJacobianMatrix(MasterVectorView u) -> void
     {
+        const ScopedTimer timer(profile.time_canonicalization);
         canonicalizer.update(jacobianMatrixMasterForm());
     }
 
@@ -213,6 +382,20 @@ struct ResidualFunction::Impl
         const auto& z = w.tail(dims.nz);
         const auto& Jc = jacobianMatrixCanonicalForm();
         residual.update({Jc, Wx, Wp, x, p, y, z, fx, v, b, h});
+        if(options.hessian == HessianMethod::QuasiNewton)
+            updateQuasiNewtonError();
+    }
+
+    /// Update the residual errors used to decide when the quasi-Newton approximation `Bxx` is restarted.
+    auto updateQuasiNewtonError() -> void
+    {
+        const auto Fc = residual.canonicalVector();
+        auto err = 0.0;
+        if(Fc.xs.size()) err = std::max(err, Fc.xs.lpNorm<Eigen::Infinity>());
+        if(Fc.p.size()) err = std::max(err, Fc.p.lpNorm<Eigen::Infinity>());
+        if(Fc.wbs.size()) err = std::max(err, Fc.wbs.lpNorm<Eigen::Infinity>());
+        qnerrorprev = qnerror;
+        qnerror = err;
     }
 
     auto jacobianMatrixMasterForm() const -> MasterMatrix
@@ -281,11 +464,21 @@ auto ResidualFunction::operator=(ResidualFunction other) -> ResidualFunction&
     return *this;
 }
 
+auto ResidualFunction::setOptions(const ResidualFunctionOptions& options) -> void
+{
+    pimpl->options = options;
+}
+
 auto ResidualFunction::initialize(const MasterProblem& problem) -> void
 {
     return pimpl->initialize(problem);
 }
 
+auto ResidualFunction::reinitialize(const MasterProblem& problem) -> void
+{
+    return pimpl->reinitialize(problem);
+}
+
 auto ResidualFunction::update(MasterVectorView u) -> void
 {
     pimpl->update(u);
@@ -306,4 +499,9 @@ auto ResidualFunction::result() const -> ResidualFunctionResult
     return pimpl->result();
 }
 
+auto ResidualFunction::profile() const -> const ResidualFunctionProfile&
+{
+    return pimpl->profile;
+}
+
 } // namespace Optima
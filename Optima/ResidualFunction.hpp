@@ -29,6 +29,7 @@
 #include <Optima/MasterProblem.hpp>
 #include <Optima/MasterVector.hpp>
 #include <Optima/ObjectiveFunction.hpp>
+#include <Optima/ResidualFunctionOptions.hpp>
 #include <Optima/Stability.hpp>
 
 namespace Optima {
@@ -42,6 +43,29 @@ struct ResidualFunctionUpdateStatus
     operator bool() const { return f && h && v; }
 };
 
+/// The evaluation counters and wall times (in unit of s) accumulated in the updates of the residual function.
+/// These are collected only if Optima is compiled with `OPTIMA_ENABLE_PROFILING`.
+/// @see Result
+struct ResidualFunctionProfile
+{
+    Index num_objective_evals = 0;     ///< The number of evaluations of the objective function.
+    Index num_objective_evals_f = 0;   ///< The number of evaluations of *f(x, p)*.
+    Index num_objective_evals_fx = 0;  ///< The number of evaluations of *fx(x, p)*.
+    Index num_objective_evals_fxx = 0; ///< The number of evaluations of *fxx(x, p)*.
+    Index num_objective_evals_fxp = 0; ///< The number of evaluations of *fxp(x, p)*.
+    Index num_constraint_evals_h = 0;  ///< The number of evaluations of *h(x, p)*.
+    Index num_constraint_evals_hx = 0; ///< The number of evaluations of *hx(x, p)*.
+    Index num_constraint_evals_hp = 0; ///< The number of evaluations of *hp(x, p)*.
+    Index num_constraint_evals_v = 0;  ///< The number of evaluations of *v(x, p)*.
+    Index num_constraint_evals_vx = 0; ///< The number of evaluations of *vx(x, p)*.
+    Index num_constraint_evals_vp = 0; ///< The number of evaluations of *vp(x, p)*.
+    double time_objective_evals = 0;   ///< The wall time spent for all objective evaluations.
+    double time_constraint_evals = 0;  ///< The wall time spent for all constraint evaluations.
+    double time_echelonization = 0;    ///< The wall time spent for the echelonization of matrix *W*.
+    double time_stability = 0;         ///< The wall time spent for the determination of stable and unstable variables.
+    double time_canonicalization = 0;  ///< The wall time spent for the canonicalization of the Jacobian matrix.
+};
+
 /// The result of the residual function evaluation at *u = (x, p, y, z)*.
 struct ResidualFunctionResult
 {
@@ -89,9 +113,18 @@ public:
     /// Assign a ResidualFunction object to this.
     auto operator=(ResidualFunction other) -> ResidualFunction&;
 
+    /// Set the options for the evaluation of the residual function.
+    auto setOptions(const ResidualFunctionOptions& options) -> void;
+
     /// Initialize the residual function once before update computations.
     auto initialize(const MasterProblem& problem) -> void;
 
+    /// Initialize the residual function again, using only the vectors *b*, *c*, *xlower* and *xupper* of the given problem.
+    /// The functions and the matrices *Ax* and *Ap* given in the last call to
+    /// @ref initialize are kept, and the echelon form of *W* is reset to the
+    /// one computed then for *Ax* and *Ap*, without echelonizing them again.
+    auto reinitialize(const MasterProblem& problem) -> void;
+
     /// Update the residual function with given *u = (x, p, y, z)*.
     auto update(MasterVectorView u) -> void;
 
@@ -104,6 +137,9 @@ public:
     /// Return the result of the evaluation of the residual function.
     auto result() const -> ResidualFunctionResult;
 
+    /// Return the evaluation counters and wall times accumulated since the last call to @ref initialize or @ref reinitialize.
+    auto profile() const -> const ResidualFunctionProfile&;
+
 private:
     struct Impl;
 
@@ -0,0 +1,61 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+namespace Optima {
+
+/// Used to describe the possible methods for computing the Hessian matrix *fxx* in the Newton steps.
+enum class HessianMethod
+{
+    /// The Hessian matrix *fxx* is evaluated by the objective function in every iteration.
+    Exact,
+
+    /// The Hessian matrix *fxx* is replaced by a quasi-Newton approximation maintained with damped BFGS updates.
+    /// The approximation is updated in every evaluation of the residual function
+    /// using the change in *x* and in the gradient *fx*, and so the objective
+    /// function is not requested to evaluate *fxx* (see ObjectiveOptions::Eval),
+    /// except possibly at the first iteration (see
+    /// ResidualFunctionOptions::hessianexactfirst) and when sensitivity
+    /// derivatives are computed. The approximation is a dense symmetric
+    /// positive definite matrix. Use it with LinearSolverMethod::Nullspace or
+    /// LinearSolverMethod::Fullspace, since LinearSolverMethod::Rangespace
+    /// requires a diagonal Hessian matrix.
+    QuasiNewton,
+};
+
+/// Used to organize the options for the evaluation of the residual function in ResidualFunction.
+struct ResidualFunctionOptions
+{
+    /// The method used to compute the Hessian matrix *fxx* in the Newton steps.
+    HessianMethod hessian = HessianMethod::Exact;
+
+    /// True if the quasi-Newton approximation starts from the exact *fxx* evaluated at the first iteration.
+    /// If false, *fxx* is never requested from the objective function during
+    /// the iterations and the approximation starts from a scaled identity
+    /// matrix. This option has effect only with HessianMethod::QuasiNewton.
+    bool hessianexactfirst = true;
+
+    /// The maximum ratio between the current and the previous residual errors for which the quasi-Newton approximation is kept.
+    /// If the residual error decreases less than this, the approximation is
+    /// restarted from the exact *fxx* evaluated in the next iteration. This
+    /// option has effect only with HessianMethod::QuasiNewton and
+    /// @ref hessianexactfirst set to true.
+    double hessiancontraction = 0.9;
+};
+
+} // namespace Optima
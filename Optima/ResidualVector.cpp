@@ -110,24 +110,37 @@ struct ResidualVector::Impl
         xs = x(js);
         xu = x(ju);
 
-        ax.resize(nx);
-        ax(js).noalias() = -(gs + tr(As)*y + tr(Js)*z);
-        ax(ju).fill(0.0);
+        // Note: the products below are accumulated in separate statements
+        // into existing vectors, so that no temporary vectors are allocated.
 
-        as = ax(js);
+        as.noalias() = -gs;
+        as.noalias() -= tr(As)*y;
+        as.noalias() -= tr(Js)*z;
         au.fill(0.0);
 
-        ay.noalias() = -(Ax*x + Ap*p - b);
+        ax.resize(nx);
+        ax(js) = as;
+        ax(ju).fill(0.0);
+
+        ay = b;
+        ay.noalias() -= Ax*x;
+        ay.noalias() -= Ap*p;
         az.noalias() = -h;
 
         ap = -v;
 
         awstar.resize(nw);
-        awstar.head(ny) = b - Au*xu;
-        awstar.tail(nz) = Js*xs + Jp*p - h;
-
-        awbs = multiplyMatrixVectorWithoutResidualRoundOffError(Rbs, awstar);
-        awbs.noalias() -= xbs + Sbsns*xns + Sbsp*args.p;
+        awstar.head(ny) = b;
+        awstar.head(ny).noalias() -= Au*xu;
+        awstar.tail(nz) = -h;
+        awstar.tail(nz).noalias() += Js*xs;
+        awstar.tail(nz).noalias() += Jp*p;
+
+        awbs.resize(nbs);
+        multiplyMatrixVectorWithoutResidualRoundOffError(Rbs, awstar, awbs);
+        awbs -= xbs;
+        awbs.noalias() -= Sbsns*xns;
+        awbs.noalias() -= Sbsp*p;
     }
 
     auto masterVector() const -> MasterVectorView
@@ -21,14 +21,31 @@ namespace Optima {
 
 auto Result::operator+=(const Result& other) -> Result&
 {
-    succeeded              = other.succeeded;
-    iterations            += other.iterations;
-    num_objective_evals   += other.num_objective_evals;
-    error                  = other.error;
-    time                  += other.time;
-    time_objective_evals  += other.time_objective_evals;
-    time_constraint_evals += other.time_constraint_evals;
-    time_linear_systems   += other.time_linear_systems;
+    succeeded                = other.succeeded;
+    failure_reason           = other.failure_reason;
+    iterations              += other.iterations;
+    error                    = other.error;
+    error_optimality         = other.error_optimality;
+    error_feasibility        = other.error_feasibility;
+    num_objective_evals     += other.num_objective_evals;
+    num_objective_evals_f   += other.num_objective_evals_f;
+    num_objective_evals_fx  += other.num_objective_evals_fx;
+    num_objective_evals_fxx += other.num_objective_evals_fxx;
+    num_objective_evals_fxp += other.num_objective_evals_fxp;
+    num_constraint_evals_h  += other.num_constraint_evals_h;
+    num_constraint_evals_hx += other.num_constraint_evals_hx;
+    num_constraint_evals_hp += other.num_constraint_evals_hp;
+    num_constraint_evals_v  += other.num_constraint_evals_v;
+    num_constraint_evals_vx += other.num_constraint_evals_vx;
+    num_constraint_evals_vp += other.num_constraint_evals_vp;
+    time                    += other.time;
+    time_objective_evals    += other.time_objective_evals;
+    time_constraint_evals   += other.time_constraint_evals;
+    time_echelonization     += other.time_echelonization;
+    time_stability          += other.time_stability;
+    time_canonicalization   += other.time_canonicalization;
+    time_linear_systems     += other.time_linear_systems;
+    time_sensitivities      += other.time_sensitivities;
 
     return *this;
 }
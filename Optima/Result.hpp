@@ -26,6 +26,9 @@
 namespace Optima {
 
 /// A type that describes the result of an optimization calculation.
+/// The evaluation counters and the wall times of the individual steps of the
+/// calculation are collected only if Optima is compiled with
+/// `OPTIMA_ENABLE_PROFILING`. Otherwise, only the total wall time is.
 class Result
 {
 public:
@@ -62,6 +65,24 @@ public:
     /// The number of evaluations of *fxp(x, p)* in the optimization calculation.
     Index num_objective_evals_fxp = 0;
 
+    /// The number of evaluations of the constraint function *h(x, p)* in the optimization calculation.
+    Index num_constraint_evals_h = 0;
+
+    /// The number of evaluations of *hx(x, p)* in the optimization calculation.
+    Index num_constraint_evals_hx = 0;
+
+    /// The number of evaluations of *hp(x, p)* in the optimization calculation.
+    Index num_constraint_evals_hp = 0;
+
+    /// The number of evaluations of the constraint function *v(x, p)* in the optimization calculation.
+    Index num_constraint_evals_v = 0;
+
+    /// The number of evaluations of *vx(x, p)* in the optimization calculation.
+    Index num_constraint_evals_vx = 0;
+
+    /// The number of evaluations of *vp(x, p)* in the optimization calculation.
+    Index num_constraint_evals_vp = 0;
+
     /// The wall time spent for the optimization calculation (in unit of s).
     double time = 0;
 
@@ -69,21 +90,34 @@ public:
     double time_objective_evals = 0;
 
     /// The wall time spent for evaluating just *f(x, p)* (in unit of s).
+    /// @note This is not collected, since *f*, *fx*, *fxx* and *fxp* are evaluated in a single call.
     double time_objective_evals_f = 0;
 
     /// The wall time spent for evaluating just *fx(x, p)* (in unit of s).
+    /// @note This is not collected, since *f*, *fx*, *fxx* and *fxp* are evaluated in a single call.
     double time_objective_evals_fx = 0;
 
     /// The wall time spent for evaluating just *fxx(x, p)* (in unit of s).
+    /// @note This is not collected, since *f*, *fx*, *fxx* and *fxp* are evaluated in a single call.
     double time_objective_evals_fxx = 0;
 
     /// The wall time spent for evaluating just *fxp(x, p)* (in unit of s).
+    /// @note This is not collected, since *f*, *fx*, *fxx* and *fxp* are evaluated in a single call.
     double time_objective_evals_fxp = 0;
 
     /// The wall time spent for all contraint evaluations (in unit of s).
     double time_constraint_evals = 0;
 
-    /// The wall time spent for all linear system solutions (in unit of s).
+    /// The wall time spent for the echelonization of the matrix *W = [Ax Ap; Jx Jp]* (in unit of s).
+    double time_echelonization = 0;
+
+    /// The wall time spent for the determination of the stable and unstable variables (in unit of s).
+    double time_stability = 0;
+
+    /// The wall time spent for the canonicalization of the Jacobian matrix (in unit of s).
+    double time_canonicalization = 0;
+
+    /// The wall time spent for all linear system solutions in the Newton steps (in unit of s).
     double time_linear_systems = 0;
 
     /// The wall time spent for computing the sensitivity derivatives (in unit of s).
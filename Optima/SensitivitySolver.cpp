@@ -27,7 +27,9 @@ struct SensitivitySolver::Impl
 {
     MasterDims dims;           ///< The dimensions of the master variables.
     LinearSolver linearsolver; ///< The linear solver for the master matrix equations.
-    MasterVector r;            ///< The right-hand side vector in the linear system problems for sensitivity computation.
+    Matrix rx;                 ///< The right-hand side vectors *rx* in the linear system problems for sensitivity computation.
+    Matrix rp;                 ///< The right-hand side vectors *rp* in the linear system problems for sensitivity computation.
+    Matrix rw;                 ///< The right-hand side vectors *rw* in the linear system problems for sensitivity computation.
     Index nc = 0;              ///< The number of sensitivity parameters *c*.
     Matrix bc;                 ///< The Jacobian matrix of *b* with respect to the sensitivity parameters *c*.
 
@@ -41,8 +43,10 @@ struct SensitivitySolver::Impl
     auto initialize(const MasterProblem& problem) -> void
     {
         dims = problem.dims;
-        r.resize(dims);
         nc = problem.c.size();
+        rx.resize(dims.nx, nc);
+        rp.resize(dims.np, nc);
+        rw.resize(dims.nw, nc);
         bc = problem.bc;
         errorif(nc && bc.cols() != nc, "MasterProblem::bc has ", bc.cols(), " columns but expected is ", nc, ".");
         errorif(nc && bc.rows() != dims.ny, "MasterProblem::bc has ", bc.rows(), " rows but expected is ", dims.ny, ".");
@@ -76,15 +80,13 @@ struct SensitivitySolver::Impl
 
         linearsolver.decompose(Jc);
 
-        for(Index i = 0; i < nc; ++i)
-        {
-            r.x(js) = -fxc.col(i)(js);
-            r.x(ju).fill(0.0);
-            r.p = -vc.col(i);
-            r.w.topRows(ny) = bc.col(i);
-            r.w.bottomRows(nz) = -hc.col(i);
-            linearsolver.solve(Jc, r, { xc.col(i), pc.col(i), wc.col(i) });
-        }
+        rx(js, all) = -fxc(js, all);
+        rx(ju, all).fill(0.0);
+        rp = -vc;
+        rw.topRows(ny) = bc;
+        rw.bottomRows(nz) = -hc;
+
+        linearsolver.solveMultiple(Jc, MasterVectorsView{rx, rp, rw}, MasterVectorsRef{xc, pc, wc});
 
         xc(jms, all).fill(0.0); // remove derivatives associated with meta-stable basic variables!
 
@@ -18,37 +18,18 @@
 #include "Solver.hpp"
 
 // Optima includes
-#include <Optima/Constants.hpp>
-#include <Optima/Exception.hpp>
-#include <Optima/IndexUtils.hpp>
-#include <Optima/MasterSolver.hpp>
 #include <Optima/Options.hpp>
 #include <Optima/Problem.hpp>
 #include <Optima/Result.hpp>
 #include <Optima/Sensitivity.hpp>
+#include <Optima/SolverSession.hpp>
 #include <Optima/State.hpp>
-#include <Optima/Timing.hpp>
-#include <Optima/Utils.hpp>
 
 namespace Optima {
 
 struct Solver::Impl
 {
-    Dims dims;                      ///< The dimensions of the variables and constraints in the optimization problem.
-    MasterSolver msolver;           ///< The master optimization solver.
-    MasterProblem mproblem;         ///< The master optimization problem.
-    MasterState mstate;             ///< The master optimization state.
-    MasterSensitivity msensitivity; ///< The sensitivity derivatives of the master optimization state.
-    Index nx    = 0;                ///< The number of variables x in xbar = (x, xbg, xhg).
-    Index nxbg  = 0;                ///< The number of variables xbg in xbar = (x, xbg, xhg).
-    Index nxhg  = 0;                ///< The number of variables xhg in xbar = (x, xbg, xhg).
-    Index nxbar = 0;                ///< The number of variables in xbar = (x, xbg, xhg).
-    Index np    = 0;                ///< The number of parameter variables p.
-    Index ny    = 0;                ///< The number of Lagrange multipliers y (i.e., the dimension of vector b = (be, bg)).
-    Index nz    = 0;                ///< The number of Lagrange multipliers z (i.e., the dimension of vector h = (he, hg)).
-    Index nwbar = 0;                ///< The number of Lagrange multipliers in wbar = (ye, yg, ze, zg).
-    Vector xbarlower;               ///< The lower bounds of vector xbar = (x, xbg, xhg) in the master optimization problem.
-    Vector xbarupper;               ///< The upper bounds of vector xbar = (x, xbg, xhg) in the master optimization problem.
+    SolverSession session; ///< The solver session initialized with the structure of each given optimization problem.
 
     /// Construct a Solver default instance.
     Impl()
@@ -58,245 +39,21 @@ struct Solver::Impl
     /// Set the options for the optimization calculation.
     auto setOptions(const Options& options) -> void
     {
-        msolver.setOptions(options);
-    }
-
-    /// Update the master problem object `mproblem` with given Problem object.
-    auto updateMasterProblem(const Problem& problem) -> void
-    {
-        // Initialize dimension variables
-        dims  = problem.dims;
-        nx    = dims.x;
-        nxbg  = dims.bg;
-        nxhg  = dims.hg;
-        nxbar = nx + nxbg + nxhg;
-        np    = dims.p;
-        ny    = dims.be + dims.bg;
-        nz    = dims.he + dims.hg;
-        nwbar = ny + nz;
-
-        errorif(!problem.f.initialized(),
-            "Cannot solve the optimization problem. "
-            "You have not initialized the objective function. "
-            "Ensure Problem::f is properly initialized.");
-
-        errorif(dims.he > 0 && !problem.he.initialized(),
-            "Cannot solve the optimization problem. "
-            "You have not initialized the constraint function he(x, p). "
-            "Ensure Problem::he is properly initialized.");
-
-        errorif(dims.hg > 0 && !problem.hg.initialized(),
-            "Cannot solve the optimization problem. "
-            "You have not initialized the constraint function hg(x, p). "
-            "Ensure Problem::hg is properly initialized.");
-
-        errorif(dims.p > 0 && !problem.v.initialized(),
-            "Cannot solve the optimization problem. "
-            "You have not initialized the complementary constraint function v(x, p). "
-            "Ensure Problem::v is properly initialized.");
-
-        // Initialize the dimensions of the master optimization problem
-        mproblem.dims = MasterDims(nxbar, np, ny, nz);
-
-        // Create the objective function for the master optimization problem
-        mproblem.f = [&](ObjectiveResultRef resbar, VectorView xbar, VectorView p, VectorView c, ObjectiveOptions opts)
-        {
-            resbar.fx.fill(0.0);
-            resbar.fxx.fill(0.0);
-            resbar.fxp.fill(0.0);
-            resbar.fxc.fill(0.0);
-
-            auto x   = xbar.head(nx);
-            auto fx  = resbar.fx.head(nx);
-            auto fxx = resbar.fxx.topLeftCorner(nx, nx);
-            auto fxp = resbar.fxp.topRows(nx);
-            auto fxc = resbar.fxc.topRows(nx);
-
-            ObjectiveResultRef fres(resbar.f, fx, fxx, fxp, fxc, resbar.diagfxx, resbar.fxx4basicvars, resbar.succeeded);
-
-            problem.f(fres, x, p, c, opts);
-        };
-
-        // Create the non-linear equality constraint for the master optimization problem
-        mproblem.h = [&](ConstraintResultRef resbar, VectorView xbar, VectorView p, VectorView c, ConstraintOptions opts)
-        {
-            // Views to sub-vectors in xbar = (x, xbg, xhg)
-            const auto x   = xbar.head(nx);
-            const auto xbg = xbar.segment(nx, nxbg);
-            const auto xhg = xbar.tail(nxhg);
-
-            // Views to sub-vectors in h = (he, hg)
-            auto he = resbar.val.head(dims.he);
-            auto hg = resbar.val.tail(dims.hg);
-
-            // Views to sub-matrices in dh/d(xbar) = [ [dhe/dx dhe/dxbg dhe/dxhg], [dhg/dx dhg/dxbg dhg/dxhg] ]
-            auto he_x   = resbar.ddx.topRows(dims.he).leftCols(nx);
-            auto he_xbg = resbar.ddx.topRows(dims.he).middleCols(nx, nxbg);
-            auto he_xhg = resbar.ddx.topRows(dims.he).rightCols(nxhg);
-
-            auto hg_x   = resbar.ddx.bottomRows(dims.hg).leftCols(nx);
-            auto hg_xbg = resbar.ddx.bottomRows(dims.hg).middleCols(nx, nxbg);
-            auto hg_xhg = resbar.ddx.bottomRows(dims.hg).rightCols(nxhg);
-
-            // Views to sub-matrices in dh/dp = [he_p; hg_p]
-            auto he_p = resbar.ddp.topRows(dims.he);
-            auto hg_p = resbar.ddp.bottomRows(dims.hg);
-
-            // Views to sub-matrices in dh/dc = [he_c; hg_c]
-            auto he_c = resbar.ddc.topRows(dims.he);
-            auto hg_c = resbar.ddc.bottomRows(dims.hg);
-
-            // Set all blocks related to xbg and xhg to zero, except hg_xhg which is identity
-            he_xbg.fill(0.0);
-            he_xhg.fill(0.0);
-            hg_xbg.fill(0.0);
-            hg_xhg.fill(0.0);
-            hg_xhg.diagonal().fill(1.0);
-
-            ConstraintResultRef heres(he, he_x, he_p, he_c, resbar.ddx4basicvars, resbar.succeeded);
-
-            problem.he(heres, x, p, c, opts);
-
-            ConstraintResultRef hgres(hg, hg_x, hg_p, hg_c, resbar.ddx4basicvars, resbar.succeeded);
-
-            problem.hg(hgres, x, p, c, opts);
-
-            hg.noalias() += xhg;
-        };
-
-        // Create the external non-linear constraint for the master optimization problem
-        mproblem.v = [&](ConstraintResultRef res, VectorView xbar, VectorView p, VectorView c, ConstraintOptions opts)
-        {
-            // Views to sub-vectors in xbar = (x, xbg, xhg)
-            const auto x   = xbar.head(nx);
-            const auto xbg = xbar.segment(nx, nxbg);
-            const auto xhg = xbar.tail(nxhg);
-
-            // Views to sub-matrices in dv/d(xbar) = [ dv/dx dv/dxbg dv/dxhg ]
-            auto v_x   = res.ddx.leftCols(nx);
-            auto v_xbg = res.ddx.middleCols(nx, nxbg);
-            auto v_xhg = res.ddx.rightCols(nxhg);
-
-            // Auxiliary references to v, vp = dv/dp, vc = dv/dc
-            auto v   = res.val;
-            auto v_p = res.ddp;
-            auto v_c = res.ddc;
-
-            // Set dv/dxbg = 0 and dv/dxhg = 0
-            v_xbg.fill(0.0);
-            v_xhg.fill(0.0);
-
-            ConstraintResultRef vres(v, v_x, v_p, v_c, res.ddx4basicvars, res.succeeded);
-
-            problem.v(vres, x, p, c, opts);
-        };
-
-        // Initialize the lower bounds of xbar = (x, xbg, xhg)
-        xbarlower.resize(nxbar);
-        xbarlower.head(nx) = problem.xlower;
-        xbarlower.tail(nxbg + nxhg).fill(-infinity());
-
-        // Initialize the upper bounds of xbar = (x, xbg, xhg)
-        xbarupper.resize(nxbar);
-        xbarupper.head(nx) = problem.xupper;
-        xbarlower.tail(nxbg + nxhg).fill(0.0);
-
-        // Initialize vector b = (be, bg)
-        mproblem.b.resize(ny);
-        mproblem.b << problem.be, problem.bg;
-
-        // Initialize lower and upper bounds for x in the master problem
-        mproblem.xlower = xbarlower;
-        mproblem.xupper = xbarupper;
-
-        // Initialize lower and upper bounds for p in the master problem
-        mproblem.plower = problem.plower;
-        mproblem.pupper = problem.pupper;
-
-        // Initialize matrix Ax = [ [Aex, 0, 0], [Agx, I, 0] ] in the master problem
-        mproblem.Ax.resize(ny, nxbar);
-        if(mproblem.Ax.size()) {
-            mproblem.Ax.leftCols(nx) << problem.Aex, problem.Agx;
-            mproblem.Ax.middleCols(nx, nxbg).bottomRows(nxbg) = identity(nxbg, nxbg);
-            mproblem.Ax.rightCols(nxhg).fill(0.0);
-        }
-
-        // Initialize matrix Ap = [ [Aep], [Agp] ] in the master problem
-        mproblem.Ap.resize(ny, np);
-        if(mproblem.Ap.size())
-            mproblem.Ap << problem.Aep, problem.Agp;
-
-        // Initialize the sensitivity parameters *c* in the master problem
-        mproblem.c = problem.c;
-
-        // Initialize the Jacobian matrix of *b* with respect to the sensitivity parameters *c*.
-        mproblem.bc.resize(ny, dims.c);
-        mproblem.bc.topRows(dims.be) = problem.bec;
-        mproblem.bc.bottomRows(dims.bg) = problem.bgc;
-    }
-
-    /// Update the master state object `mstate` with given State object.
-    auto updateMasterState(const State& state) -> void
-    {
-        // Initialize xbar = (x, xbg, xhg)
-        mstate.u.x.resize(nxbar);
-        mstate.u.x << state.x, state.xbg, state.xhg;
-
-        // Initialize wbar = (ye, yg, ze, zg)
-        mstate.u.w.resize(nwbar);
-        mstate.u.w << state.ye, state.yg, state.ze, state.zg;
-
-        // Initialize pbar = p
-        mstate.u.p = state.p;
-    }
-
-    /// Update the given State object with computed MasterState object `mstate`.
-    auto updateState(State& state) -> void
-    {
-        state.x   = mstate.u.x.head(nx);
-        state.xbg = mstate.u.x.segment(nx, nxbg);
-        state.xhg = mstate.u.x.tail(nxhg);
-        state.ye  = mstate.u.w.head(ny).head(dims.be);
-        state.yg  = mstate.u.w.head(ny).tail(dims.bg);
-        state.ze  = mstate.u.w.tail(nz).head(dims.he);
-        state.zg  = mstate.u.w.tail(nz).tail(dims.hg);
-        state.p   = mstate.u.p;
-    }
-
-    /// Update the given Sensitivity object with computed MasterSensitivity object `msensitivity`.
-    auto updateSensitivity(Sensitivity& sensitivity) -> void
-    {
-        sensitivity.resize(dims);
-        sensitivity.xc   = msensitivity.xc.topRows(nx);
-        sensitivity.pc   = msensitivity.pc;
-        sensitivity.xbgc = msensitivity.xc.middleRows(nx, nxbg);
-        sensitivity.xhgc = msensitivity.xc.bottomRows(nxhg);
-        sensitivity.yec  = msensitivity.wc.topRows(ny).topRows(dims.be);
-        sensitivity.ygc  = msensitivity.wc.topRows(ny).bottomRows(dims.bg);
-        sensitivity.zec  = msensitivity.wc.bottomRows(nz).topRows(dims.he);
-        sensitivity.zgc  = msensitivity.wc.bottomRows(nz).bottomRows(dims.hg);
-        sensitivity.sc   = msensitivity.sc.topRows(nx);
+        session.setOptions(options);
     }
 
     /// Solve the optimization problem.
     auto solve(const Problem& problem, State& state) -> Result
     {
-        updateMasterProblem(problem);
-        updateMasterState(state);
-        const auto result = msolver.solve(mproblem, mstate);
-        updateState(state);
-        return result;
+        session.initialize(problem);
+        return session.solve(state);
     }
 
     /// Solve the optimization problem and compute the sensitivity derivatives at the end.
     auto solve(const Problem& problem, State& state, Sensitivity& sensitivity) -> Result
     {
-        updateMasterProblem(problem);
-        updateMasterState(state);
-        const auto result = msolver.solve(mproblem, mstate, msensitivity);
-        updateState(state);
-        updateSensitivity(sensitivity);
-        return result;
+        session.initialize(problem);
+        return session.solve(state, sensitivity);
     }
 };
 
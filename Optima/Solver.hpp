@@ -53,6 +53,10 @@ public:
     auto setOptions(const Options& options) -> void;
 
     /// Solve the optimization problem.
+    /// The structure of the given problem (its functions and coefficient
+    /// matrices) is processed in every call, since it may have changed since
+    /// the previous one. Use SolverSession instead to process it only once
+    /// for a sequence of problems in which only their vectors change.
     auto solve(const Problem& problem, State& state) -> Result;
 
     /// Solve the optimization problem and compute the sensitivity derivatives at the end.
@@ -0,0 +1,441 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "SolverSession.hpp"
+
+// Optima includes
+#include <Optima/Exception.hpp>
+#include <Optima/MasterSolver.hpp>
+#include <Optima/Options.hpp>
+#include <Optima/Problem.hpp>
+#include <Optima/Result.hpp>
+#include <Optima/Sensitivity.hpp>
+#include <Optima/State.hpp>
+#include <Optima/Utils.hpp>
+
+namespace Optima {
+
+struct SolverSession::Impl
+{
+    Dims dims;                      ///< The dimensions of the variables and constraints in the optimization problem.
+    MasterSolver msolver;           ///< The master optimization solver.
+    MasterProblem mproblem;         ///< The master optimization problem.
+    MasterState mstate;             ///< The master optimization state.
+    MasterSensitivity msensitivity; ///< The sensitivity derivatives of the master optimization state.
+    Index nx    = 0;                ///< The number of variables x in xbar = (x, xbg, xhg).
+    Index nxbg  = 0;                ///< The number of variables xbg in xbar = (x, xbg, xhg).
+    Index nxhg  = 0;                ///< The number of variables xhg in xbar = (x, xbg, xhg).
+    Index nxbar = 0;                ///< The number of variables in xbar = (x, xbg, xhg).
+    Index np    = 0;                ///< The number of parameter variables p.
+    Index ny    = 0;                ///< The number of Lagrange multipliers y (i.e., the dimension of vector b = (be, bg)).
+    Index nz    = 0;                ///< The number of Lagrange multipliers z (i.e., the dimension of vector h = (he, hg)).
+    Index nwbar = 0;                ///< The number of Lagrange multipliers in wbar = (ye, yg, ze, zg).
+    bool initialized = false;       ///< The boolean flag that indicates whether the session has been initialized with a Problem object.
+
+    /// Construct a default SolverSession::Impl instance.
+    Impl()
+    {
+    }
+
+    /// Set the options for the optimization calculation.
+    auto setOptions(const Options& options) -> void
+    {
+        msolver.setOptions(options);
+    }
+
+    /// Initialize the master problem object `mproblem` with given Problem object.
+    auto initialize(const Problem& problem) -> void
+    {
+        // Ensure a failed initialization leaves this session uninitialized
+        initialized = false;
+
+        // Initialize dimension variables
+        dims  = problem.dims;
+        nx    = dims.x;
+        nxbg  = dims.bg;
+        nxhg  = dims.hg;
+        nxbar = nx + nxbg + nxhg;
+        np    = dims.p;
+        ny    = dims.be + dims.bg;
+        nz    = dims.he + dims.hg;
+        nwbar = ny + nz;
+
+        errorif(!problem.f.initialized(),
+            "Cannot solve the optimization problem. "
+            "You have not initialized the objective function. "
+            "Ensure Problem::f is properly initialized.");
+
+        errorif(dims.he > 0 && !problem.he.initialized(),
+            "Cannot solve the optimization problem. "
+            "You have not initialized the constraint function he(x, p). "
+            "Ensure Problem::he is properly initialized.");
+
+        errorif(dims.hg > 0 && !problem.hg.initialized(),
+            "Cannot solve the optimization problem. "
+            "You have not initialized the constraint function hg(x, p). "
+            "Ensure Problem::hg is properly initialized.");
+
+        errorif(dims.p > 0 && !problem.v.initialized(),
+            "Cannot solve the optimization problem. "
+            "You have not initialized the complementary constraint function v(x, p). "
+            "Ensure Problem::v is properly initialized.");
+
+        // Initialize the dimensions of the master optimization problem
+        mproblem.dims = MasterDims(nxbar, np, ny, nz);
+
+        // The functions below capture copies of the problem functions and
+        // dimensions, so that they remain valid after the given Problem object
+        // is destroyed and after this session is copied.
+        const auto nx   = this->nx;
+        const auto nxbg = this->nxbg;
+        const auto nxhg = this->nxhg;
+        const auto dims = this->dims;
+
+        // Create the objective function for the master optimization problem
+        mproblem.f = [=, f = problem.f](ObjectiveResultRef resbar, VectorView xbar, VectorView p, VectorView c, ObjectiveOptions opts)
+        {
+            resbar.fx.fill(0.0);
+            resbar.fxx.fill(0.0);
+            resbar.fxp.fill(0.0);
+            resbar.fxc.fill(0.0);
+
+            auto x   = xbar.head(nx);
+            auto fx  = resbar.fx.head(nx);
+            auto fxx = resbar.fxx.topLeftCorner(nx, nx);
+            auto fxp = resbar.fxp.topRows(nx);
+            auto fxc = resbar.fxc.topRows(nx);
+
+            ObjectiveResultRef fres(resbar.f, fx, fxx, fxp, fxc, resbar.diagfxx, resbar.fxx4basicvars, resbar.succeeded);
+
+            f(fres, x, p, c, opts);
+        };
+
+        // Create the non-linear equality constraint for the master optimization problem
+        mproblem.h = [=, he = problem.he, hg = problem.hg](ConstraintResultRef resbar, VectorView xbar, VectorView p, VectorView c, ConstraintOptions opts)
+        {
+            // Views to sub-vectors in xbar = (x, xbg, xhg)
+            const auto x   = xbar.head(nx);
+            const auto xhg = xbar.tail(nxhg);
+
+            // Views to sub-vectors in h = (he, hg)
+            auto heval = resbar.val.head(dims.he);
+            auto hgval = resbar.val.tail(dims.hg);
+
+            // Views to sub-matrices in dh/d(xbar) = [ [dhe/dx dhe/dxbg dhe/dxhg], [dhg/dx dhg/dxbg dhg/dxhg] ]
+            auto he_x   = resbar.ddx.topRows(dims.he).leftCols(nx);
+            auto he_xbg = resbar.ddx.topRows(dims.he).middleCols(nx, nxbg);
+            auto he_xhg = resbar.ddx.topRows(dims.he).rightCols(nxhg);
+
+            auto hg_x   = resbar.ddx.bottomRows(dims.hg).leftCols(nx);
+            auto hg_xbg = resbar.ddx.bottomRows(dims.hg).middleCols(nx, nxbg);
+            auto hg_xhg = resbar.ddx.bottomRows(dims.hg).rightCols(nxhg);
+
+            // Views to sub-matrices in dh/dp = [he_p; hg_p]
+            auto he_p = resbar.ddp.topRows(dims.he);
+            auto hg_p = resbar.ddp.bottomRows(dims.hg);
+
+            // Views to sub-matrices in dh/dc = [he_c; hg_c]
+            auto he_c = resbar.ddc.topRows(dims.he);
+            auto hg_c = resbar.ddc.bottomRows(dims.hg);
+
+            // Set all blocks related to xbg and xhg to zero, except hg_xhg which is identity
+            he_xbg.fill(0.0);
+            he_xhg.fill(0.0);
+            hg_xbg.fill(0.0);
+            hg_xhg.fill(0.0);
+            hg_xhg.diagonal().fill(1.0);
+
+            ConstraintResultRef heres(heval, he_x, he_p, he_c, resbar.ddx4basicvars, resbar.succeeded);
+
+            he(heres, x, p, c, opts);
+
+            ConstraintResultRef hgres(hgval, hg_x, hg_p, hg_c, resbar.ddx4basicvars, resbar.succeeded);
+
+            hg(hgres, x, p, c, opts);
+
+            hgval.noalias() += xhg;
+        };
+
+        // Create the external non-linear constraint for the master optimization problem
+        mproblem.v = [=, v = problem.v](ConstraintResultRef res, VectorView xbar, VectorView p, VectorView c, ConstraintOptions opts)
+        {
+            // View to sub-vector x in xbar = (x, xbg, xhg)
+            const auto x = xbar.head(nx);
+
+            // Views to sub-matrices in dv/d(xbar) = [ dv/dx dv/dxbg dv/dxhg ]
+            auto v_x   = res.ddx.leftCols(nx);
+            auto v_xbg = res.ddx.middleCols(nx, nxbg);
+            auto v_xhg = res.ddx.rightCols(nxhg);
+
+            // Auxiliary references to v, vp = dv/dp, vc = dv/dc
+            auto vval = res.val;
+            auto v_p  = res.ddp;
+            auto v_c  = res.ddc;
+
+            // Set dv/dxbg = 0 and dv/dxhg = 0
+            v_xbg.fill(0.0);
+            v_xhg.fill(0.0);
+
+            ConstraintResultRef vres(vval, v_x, v_p, v_c, res.ddx4basicvars, res.succeeded);
+
+            v(vres, x, p, c, opts);
+        };
+
+        // Initialize the lower and upper bounds of xbar = (x, xbg, xhg), where xbg <= 0 and xhg <= 0
+        mproblem.xlower.resize(nxbar);
+        mproblem.xupper.resize(nxbar);
+        mproblem.xlower.tail(nxbg + nxhg).fill(-infinity());
+        mproblem.xupper.tail(nxbg + nxhg).fill(0.0);
+
+        // Initialize the lower and upper bounds of p
+        mproblem.plower.resize(np);
+        mproblem.pupper.resize(np);
+
+        // Initialize vector b = (be, bg) and the sensitivity parameters c
+        mproblem.b.resize(ny);
+        mproblem.c.resize(dims.c);
+
+        // Initialize matrix Ax = [ [Aex, 0, 0], [Agx, I, 0] ] in the master problem
+        mproblem.Ax.resize(ny, nxbar);
+        if(mproblem.Ax.size()) {
+            mproblem.Ax.leftCols(nx) << problem.Aex, problem.Agx;
+            mproblem.Ax.middleCols(nx, nxbg).topRows(dims.be).fill(0.0);
+            mproblem.Ax.middleCols(nx, nxbg).bottomRows(nxbg) = identity(nxbg, nxbg);
+            mproblem.Ax.rightCols(nxhg).fill(0.0);
+        }
+
+        // Initialize matrix Ap = [ [Aep], [Agp] ] in the master problem
+        mproblem.Ap.resize(ny, np);
+        if(mproblem.Ap.size())
+            mproblem.Ap << problem.Aep, problem.Agp;
+
+        // Initialize the Jacobian matrix of *b* with respect to the sensitivity parameters *c*.
+        mproblem.bc.resize(ny, dims.c);
+        mproblem.bc.topRows(dims.be) = problem.bec;
+        mproblem.bc.bottomRows(dims.bg) = problem.bgc;
+
+        // Initialize the data of the master problem that can change between solves
+        setbe(problem.be);
+        setbg(problem.bg);
+        setc(problem.c);
+        setxlower(problem.xlower);
+        setxupper(problem.xupper);
+        setplower(problem.plower);
+        setpupper(problem.pupper);
+
+        // Process the structure of the master problem, which is not done again in the solve methods below
+        msolver.initialize(mproblem);
+
+        initialized = true;
+    }
+
+    /// Set the right-hand side vector *be* in the master problem.
+    auto setbe(VectorView be) -> void
+    {
+        errorif(be.size() != dims.be, "Expecting vector be with size ", dims.be, " but got ", be.size(), ".");
+        mproblem.b.head(dims.be) = be;
+    }
+
+    /// Set the right-hand side vector *bg* in the master problem.
+    auto setbg(VectorView bg) -> void
+    {
+        errorif(bg.size() != dims.bg, "Expecting vector bg with size ", dims.bg, " but got ", bg.size(), ".");
+        mproblem.b.tail(dims.bg) = bg;
+    }
+
+    /// Set the sensitivity parameters *c* in the master problem.
+    auto setc(VectorView c) -> void
+    {
+        errorif(c.size() != dims.c, "Expecting vector c with size ", dims.c, " but got ", c.size(), ".");
+        mproblem.c = c;
+    }
+
+    /// Set the lower bounds of *x* in the master problem.
+    auto setxlower(VectorView xlower) -> void
+    {
+        errorif(xlower.size() != nx, "Expecting vector xlower with size ", nx, " but got ", xlower.size(), ".");
+        mproblem.xlower.head(nx) = xlower;
+    }
+
+    /// Set the upper bounds of *x* in the master problem.
+    auto setxupper(VectorView xupper) -> void
+    {
+        errorif(xupper.size() != nx, "Expecting vector xupper with size ", nx, " but got ", xupper.size(), ".");
+        mproblem.xupper.head(nx) = xupper;
+    }
+
+    /// Set the lower bounds of *p* in the master problem.
+    auto setplower(VectorView plower) -> void
+    {
+        errorif(plower.size() != np, "Expecting vector plower with size ", np, " but got ", plower.size(), ".");
+        mproblem.plower = plower;
+    }
+
+    /// Set the upper bounds of *p* in the master problem.
+    auto setpupper(VectorView pupper) -> void
+    {
+        errorif(pupper.size() != np, "Expecting vector pupper with size ", np, " but got ", pupper.size(), ".");
+        mproblem.pupper = pupper;
+    }
+
+    /// Update the master state object `mstate` with given State object.
+    auto updateMasterState(const State& state) -> void
+    {
+        // Initialize xbar = (x, xbg, xhg)
+        mstate.u.x.resize(nxbar);
+        mstate.u.x << state.x, state.xbg, state.xhg;
+
+        // Initialize wbar = (ye, yg, ze, zg)
+        mstate.u.w.resize(nwbar);
+        mstate.u.w << state.ye, state.yg, state.ze, state.zg;
+
+        // Initialize pbar = p
+        mstate.u.p = state.p;
+    }
+
+    /// Update the given State object with computed MasterState object `mstate`.
+    auto updateState(State& state) -> void
+    {
+        state.x   = mstate.u.x.head(nx);
+        state.xbg = mstate.u.x.segment(nx, nxbg);
+        state.xhg = mstate.u.x.tail(nxhg);
+        state.ye  = mstate.u.w.head(ny).head(dims.be);
+        state.yg  = mstate.u.w.head(ny).tail(dims.bg);
+        state.ze  = mstate.u.w.tail(nz).head(dims.he);
+        state.zg  = mstate.u.w.tail(nz).tail(dims.hg);
+        state.p   = mstate.u.p;
+    }
+
+    /// Update the given Sensitivity object with computed MasterSensitivity object `msensitivity`.
+    auto updateSensitivity(Sensitivity& sensitivity) -> void
+    {
+        sensitivity.resize(dims);
+        sensitivity.xc   = msensitivity.xc.topRows(nx);
+        sensitivity.pc   = msensitivity.pc;
+        sensitivity.xbgc = msensitivity.xc.middleRows(nx, nxbg);
+        sensitivity.xhgc = msensitivity.xc.bottomRows(nxhg);
+        sensitivity.yec  = msensitivity.wc.topRows(ny).topRows(dims.be);
+        sensitivity.ygc  = msensitivity.wc.topRows(ny).bottomRows(dims.bg);
+        sensitivity.zec  = msensitivity.wc.bottomRows(nz).topRows(dims.he);
+        sensitivity.zgc  = msensitivity.wc.bottomRows(nz).bottomRows(dims.hg);
+        sensitivity.sc   = msensitivity.sc.topRows(nx);
+    }
+
+    /// Solve the optimization problem.
+    auto solve(State& state) -> Result
+    {
+        errorif(!initialized, "Cannot solve the optimization problem in this SolverSession object. "
+            "You have not initialized it with a Problem object.");
+        updateMasterState(state);
+        const auto result = msolver.resolve(mproblem, mstate);
+        updateState(state);
+        return result;
+    }
+
+    /// Solve the optimization problem and compute the sensitivity derivatives at the end.
+    auto solve(State& state, Sensitivity& sensitivity) -> Result
+    {
+        errorif(!initialized, "Cannot solve the optimization problem in this SolverSession object. "
+            "You have not initialized it with a Problem object.");
+        updateMasterState(state);
+        const auto result = msolver.resolve(mproblem, mstate, msensitivity);
+        updateState(state);
+        updateSensitivity(sensitivity);
+        return result;
+    }
+};
+
+SolverSession::SolverSession()
+: pimpl(new Impl())
+{}
+
+SolverSession::SolverSession(const Problem& problem)
+: pimpl(new Impl())
+{
+    pimpl->initialize(problem);
+}
+
+SolverSession::SolverSession(const SolverSession& other)
+: pimpl(new Impl(*other.pimpl))
+{}
+
+SolverSession::~SolverSession()
+{}
+
+auto SolverSession::operator=(SolverSession other) -> SolverSession&
+{
+    pimpl = std::move(other.pimpl);
+    return *this;
+}
+
+auto SolverSession::initialize(const Problem& problem) -> void
+{
+    pimpl->initialize(problem);
+}
+
+auto SolverSession::setOptions(const Options& options) -> void
+{
+    pimpl->setOptions(options);
+}
+
+auto SolverSession::setbe(VectorView be) -> void
+{
+    pimpl->setbe(be);
+}
+
+auto SolverSession::setbg(VectorView bg) -> void
+{
+    pimpl->setbg(bg);
+}
+
+auto SolverSession::setc(VectorView c) -> void
+{
+    pimpl->setc(c);
+}
+
+auto SolverSession::setxlower(VectorView xlower) -> void
+{
+    pimpl->setxlower(xlower);
+}
+
+auto SolverSession::setxupper(VectorView xupper) -> void
+{
+    pimpl->setxupper(xupper);
+}
+
+auto SolverSession::setplower(VectorView plower) -> void
+{
+    pimpl->setplower(plower);
+}
+
+auto SolverSession::setpupper(VectorView pupper) -> void
+{
+    pimpl->setpupper(pupper);
+}
+
+auto SolverSession::solve(State& state) -> Result
+{
+    return pimpl->solve(state);
+}
+
+auto SolverSession::solve(State& state, Sensitivity& sensitivity) -> Result
+{
+    return pimpl->solve(state, sensitivity);
+}
+
+} // namespace Optima
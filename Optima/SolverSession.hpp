@@ -0,0 +1,105 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+// C++ includes
+#include <memory>
+
+// Optima includes
+#include <Optima/Matrix.hpp>
+
+namespace Optima {
+
+// Forward declarations
+class Options;
+class Problem;
+class Result;
+class Sensitivity;
+class State;
+
+/// The solver for a sequence of optimization problems sharing the same structure.
+/// A SolverSession object processes the structure of an optimization problem
+/// only once, at initialization: its dimensions, its objective and constraint
+/// functions, and its coefficient matrices, whose echelon form is computed
+/// then and reused afterwards. These are assembled into the master
+/// optimization problem solved in every subsequent call to @ref solve. Between
+/// calls, only the data that typically change in a sequence of calculations
+/// (the right-hand side vectors *be* and *bg*, the sensitivity parameters *c*,
+/// and the bounds of *x* and *p*) are updated using the set methods below, so
+/// that each solve pays only for the Newton iterations.
+class SolverSession
+{
+public:
+    /// Construct a default SolverSession instance.
+    SolverSession();
+
+    /// Construct a SolverSession instance with given optimization problem.
+    explicit SolverSession(const Problem& problem);
+
+    /// Construct a copy of a SolverSession instance.
+    SolverSession(const SolverSession& other);
+
+    /// Destroy this SolverSession instance.
+    virtual ~SolverSession();
+
+    /// Assign a SolverSession instance to this.
+    auto operator=(SolverSession other) -> SolverSession&;
+
+    /// Initialize this session with the structure and data of an optimization problem.
+    /// The objective and constraint functions of the problem are copied into
+    /// this session, so that the given Problem object does not need to outlive it.
+    auto initialize(const Problem& problem) -> void;
+
+    /// Set the options for the optimization calculation.
+    auto setOptions(const Options& options) -> void;
+
+    /// Set the right-hand side vector *be* in the linear equality constraints.
+    auto setbe(VectorView be) -> void;
+
+    /// Set the right-hand side vector *bg* in the linear inequality constraints.
+    auto setbg(VectorView bg) -> void;
+
+    /// Set the sensitivity parameters *c*.
+    auto setc(VectorView c) -> void;
+
+    /// Set the lower bounds of the primal variables *x*.
+    auto setxlower(VectorView xlower) -> void;
+
+    /// Set the upper bounds of the primal variables *x*.
+    auto setxupper(VectorView xupper) -> void;
+
+    /// Set the lower bounds of the parameter variables *p*.
+    auto setplower(VectorView plower) -> void;
+
+    /// Set the upper bounds of the parameter variables *p*.
+    auto setpupper(VectorView pupper) -> void;
+
+    /// Solve the optimization problem of this session.
+    auto solve(State& state) -> Result;
+
+    /// Solve the optimization problem of this session and compute the sensitivity derivatives at the end.
+    auto solve(State& state, Sensitivity& sensitivity) -> Result;
+
+private:
+    struct Impl;
+
+    std::unique_ptr<Impl> pimpl;
+};
+
+} // namespace Optima
@@ -60,4 +60,40 @@ auto elapsed(const Time& end, const Time& begin) -> double;
 /// @return The elapsed time between now and *begin* in seconds
 auto elapsed(const Time& begin) -> double;
 
+/// True if Optima is compiled with `OPTIMA_ENABLE_PROFILING`, in which case
+/// the wall time and number of evaluations of the main steps of the
+/// calculations are collected.
+#ifdef OPTIMA_ENABLE_PROFILING
+constexpr auto PROFILING = true;
+#else
+constexpr auto PROFILING = false;
+#endif
+
+/// Used to add the wall time spent in a scope to a given accumulator.
+/// The elapsed time is measured only if `PROFILING` is true, otherwise
+/// this object has no effect and is optimized away.
+class ScopedTimer
+{
+public:
+    /// Construct a ScopedTimer instance with given accumulator of wall time (in seconds).
+    explicit ScopedTimer(double& total)
+    : total(total), begin(PROFILING ? timenow() : Time()) {}
+
+    /// Destroy this ScopedTimer instance, adding the elapsed time to the accumulator.
+    ~ScopedTimer() { if(PROFILING) total += elapsed(begin); }
+
+    /// Disable copy construction of ScopedTimer instances.
+    ScopedTimer(const ScopedTimer&) = delete;
+
+    /// Disable copy assignment of ScopedTimer instances.
+    auto operator=(const ScopedTimer&) -> ScopedTimer& = delete;
+
+private:
+    /// The accumulator of wall time.
+    double& total;
+
+    /// The time at which this ScopedTimer object was created.
+    Time begin;
+};
+
 } // namespace Optima
@@ -559,6 +559,13 @@ auto cleanResidualRoundoffErrors(MatrixRef mat) -> void
 }
 
 auto multiplyMatrixVectorWithoutResidualRoundOffError(MatrixView A, VectorView x) -> Vector
+{
+    Vector b(A.rows());
+    multiplyMatrixVectorWithoutResidualRoundOffError(A, x, b);
+    return b;
+}
+
+auto multiplyMatrixVectorWithoutResidualRoundOffError(MatrixView A, VectorView x, VectorRef b) -> void
 {
     // In this method, we use b' = |A|*|x| as a reference to determine which
     // small entries in b should be regarded as residual round-off error. The
@@ -566,8 +573,9 @@ auto multiplyMatrixVectorWithoutResidualRoundOffError(MatrixView A, VectorView x
     // errors, then b'[i] should also be small.
 
     assert(A.cols() == x.rows());
+    assert(A.rows() == b.rows());
 
-    Vector b = A * x;
+    b.noalias() = A * x;
     const auto eps = std::numeric_limits<double>::epsilon();
     for(auto i = 0; i < b.size(); ++i)
     {
@@ -575,7 +583,6 @@ auto multiplyMatrixVectorWithoutResidualRoundOffError(MatrixView A, VectorView x
         if(std::abs(b[i]) < ref * eps)
             b[i] = 0.0;
     }
-    return b;
 }
 
 auto matrixStructure(MatrixView mat) -> MatrixStructure
@@ -617,4 +624,37 @@ auto ensureMinimumDimension(Matrix& mat, Index rows, Index cols) -> void
     mat.resize(m, n);
 }
 
+auto ensureMinimumDimension(MatrixXf& mat, Index rows, Index cols) -> void
+{
+    const auto m = std::max(mat.rows(), rows);
+    const auto n = std::max(mat.cols(), cols);
+    mat.resize(m, n);
+}
+
+auto ensureMinimumDimension(Indices& vec, Index size) -> void
+{
+    if(vec.size() < size)
+        vec.resize(size);
+}
+
+auto ensureMinimumDimension(Vector& vec, Index size) -> void
+{
+    if(vec.size() < size)
+        vec.resize(size);
+}
+
+auto isSymmetric(MatrixView A) -> bool
+{
+    assert(A.rows() == A.cols());
+    const auto n = A.rows();
+    if(n == 0)
+        return true;
+    const auto tol = 1e-13 * A.cwiseAbs().maxCoeff();
+    for(Index j = 0; j < n; ++j)
+        for(Index i = j + 1; i < n; ++i)
+            if(std::abs(A(i, j) - A(j, i)) > tol)
+                return false;
+    return true;
+}
+
 } // namespace Optima
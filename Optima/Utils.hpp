@@ -176,6 +176,9 @@ auto cleanResidualRoundoffErrors(MatrixRef mat) -> void;
 /// Multiply a matrix and a vector and clean residual round-off errors.
 auto multiplyMatrixVectorWithoutResidualRoundOffError(MatrixView A, VectorView x) -> Vector;
 
+/// Multiply a matrix and a vector and clean residual round-off errors, storing the result in a given vector.
+auto multiplyMatrixVectorWithoutResidualRoundOffError(MatrixView A, VectorView x, VectorRef b) -> void;
+
 /// Used to describe the structure of a matrix.
 enum class MatrixStructure
 {
@@ -204,4 +207,16 @@ auto operator<<=(MatrixRef mat, MatrixView other) -> MatrixRef;
 /// then no resizing is performed.
 auto ensureMinimumDimension(Matrix& mat, Index rows, Index cols) -> void;
 
+/// Resize a single-precision matrix if its current number of rows or columns is inferior to given ones.
+auto ensureMinimumDimension(MatrixXf& mat, Index rows, Index cols) -> void;
+
+/// Resize a vector of indices if its current dimension is inferior to a given one.
+auto ensureMinimumDimension(Indices& vec, Index size) -> void;
+
+/// Resize a vector if its current dimension is inferior to a given one.
+auto ensureMinimumDimension(Vector& vec, Index size) -> void;
+
+/// Return true if a square matrix is symmetric up to round-off errors relative to its largest absolute entry.
+auto isSymmetric(MatrixView A) -> bool;
+
 } // namespace Optima
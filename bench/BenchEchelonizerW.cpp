@@ -0,0 +1,44 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+// Optima includes
+#include <Optima/EchelonizerW.hpp>
+using namespace Optima;
+
+// Optima benchmark includes
+#include "BenchUtils.hpp"
+
+int main(int argc, char **argv)
+{
+    benchPrintHeader();
+
+    for(auto dims : benchDims(benchMaxSize(argc, argv)))
+    {
+        BenchMasterMatrix data(dims, false);
+
+        // Alternate between two sets of priority weights so that every update needs basis swaps
+        const Vector weights[2] = { data.weights, data.weights.reverse() };
+
+        Index k = 0;
+
+        EchelonizerW echelonizerW;
+
+        benchPrint("EchelonizerW::initialize", "", false, dims, benchMeasure([&] { echelonizerW.initialize(dims, data.Ax, data.Ap); }));
+        benchPrint("EchelonizerW::update", "", false, dims, benchMeasure([&] { echelonizerW.update(data.Jx, data.Jp, weights[k++ % 2]); }));
+    }
+}
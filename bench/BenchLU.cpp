@@ -0,0 +1,43 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+// Optima includes
+#include <Optima/LU.hpp>
+using namespace Optima;
+
+// Optima benchmark includes
+#include "BenchUtils.hpp"
+
+int main(int argc, char **argv)
+{
+    benchPrintHeader();
+
+    for(auto n : benchSizes(benchMaxSize(argc, argv)))
+    {
+        const MasterDims dims(n, 0, 0, 0);
+
+        const Matrix A = random(n, n);
+        const Vector b = random(n);
+        Vector x(n);
+
+        LU lu;
+
+        benchPrint("LU::decompose", "", false, dims, benchMeasure([&] { lu.decompose(A); }));
+        benchPrint("LU::solve", "", false, dims, benchMeasure([&] { lu.solve(b, x); }));
+    }
+}
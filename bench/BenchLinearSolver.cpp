@@ -0,0 +1,92 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+// Optima includes
+#include <Optima/Canonicalizer.hpp>
+#include <Optima/LinearSolver.hpp>
+#include <Optima/MasterMatrixOps.hpp>
+#include <Optima/MasterVector.hpp>
+using namespace Optima;
+
+// Optima benchmark includes
+#include "BenchUtils.hpp"
+
+int main(int argc, char **argv)
+{
+    benchPrintHeader();
+
+    const auto methods = {
+        LinearSolverMethod::Fullspace,
+        LinearSolverMethod::Nullspace,
+        LinearSolverMethod::Rangespace,
+        LinearSolverMethod::Sparse,
+        LinearSolverMethod::Iterative,
+        LinearSolverMethod::Automatic };
+
+    for(auto dims : benchDims(benchMaxSize(argc, argv)))
+    {
+        for(auto diagHxx : {false, true})
+        {
+            const BenchMasterMatrix data(dims, diagHxx);
+            const MasterMatrix M = data.matrix();
+
+            Canonicalizer canonicalizer(M);
+            const CanonicalMatrix Mc = canonicalizer.canonicalMatrix();
+
+            MasterVector u(dims);
+            u.x = linspace(dims.nx, 1, dims.nx);
+            u.p = linspace(dims.np, 1, dims.np);
+            u.w = linspace(dims.nw, 1, dims.nw);
+
+            const MasterVector a = M * u;
+
+            const Index k = 100; // the number of right-hand side vectors in the multiple right-hand side solves
+
+            const Matrix ax = a.x.replicate(1, k);
+            const Matrix ap = a.p.replicate(1, k);
+            const Matrix aw = a.w.replicate(1, k);
+
+            Matrix ux(dims.nx, k);
+            Matrix up(dims.np, k);
+            Matrix uw(dims.nw, k);
+
+            for(auto method : methods)
+            for(auto mixed : {false, true})
+            {
+                if(method == LinearSolverMethod::Rangespace && !diagHxx)
+                    continue; // the Rangespace method is only applicable to diagonal Hxx matrices
+
+                if(mixed && method != LinearSolverMethod::Fullspace && method != LinearSolverMethod::Nullspace)
+                    continue; // the single-precision decomposition is only applicable to methods Fullspace and Nullspace
+
+                LinearSolverOptions options;
+                options.method = method;
+                options.mixedprecision = mixed;
+
+                LinearSolver linearsolver;
+                linearsolver.setOptions(options);
+
+                const auto name = benchMethodName(method) + (mixed ? "+mixedprecision" : "");
+
+                benchPrint("LinearSolver::decompose", name, diagHxx, dims, benchMeasure([&] { linearsolver.decompose(Mc); }));
+                benchPrint("LinearSolver::solve", name, diagHxx, dims, benchMeasure([&] { linearsolver.solve(Mc, a, u); }));
+                benchPrint("LinearSolver::solveMultiple(100)", name, diagHxx, dims, benchMeasure([&] { linearsolver.solveMultiple(Mc, MasterVectorsView{ax, ap, aw}, MasterVectorsRef{ux, up, uw}); }));
+            }
+        }
+    }
+}
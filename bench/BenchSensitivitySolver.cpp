@@ -0,0 +1,98 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+// Optima includes
+#include <Optima/MasterProblem.hpp>
+#include <Optima/MasterSensitivity.hpp>
+#include <Optima/MasterState.hpp>
+#include <Optima/ResidualFunction.hpp>
+#include <Optima/SensitivitySolver.hpp>
+using namespace Optima;
+
+// Optima benchmark includes
+#include "BenchUtils.hpp"
+
+int main(int argc, char **argv)
+{
+    benchPrintHeader();
+
+    for(auto dims : benchDims(benchMaxSize(argc, argv)))
+    {
+        const auto [nx, np, ny, nz, nw, nt] = dims;
+
+        const BenchMasterMatrix data(dims, false);
+
+        const auto nc = ny; // the sensitivity parameters c are the right-hand side values b in Ax*x + Ap*p = b
+
+        const Matrix Hxx = data.Hxx;
+        const Matrix Hxp = data.Hxp;
+        const Matrix Vpx = data.Vpx;
+        const Matrix Vpp = data.Vpp;
+        const Matrix Jx  = data.Jx;
+        const Matrix Jp  = data.Jp;
+
+        MasterProblem problem;
+        problem.dims = dims;
+        problem.f = [=](ObjectiveResultRef res, VectorView x, VectorView p, VectorView c, ObjectiveOptions opts)
+        {
+            res.f = 0.5 * x.dot(Hxx * x) + x.dot(Hxp * p);
+            res.fx = Hxx * x + Hxp * p;
+            res.fxx = Hxx;
+            res.fxp = Hxp;
+            res.fxc.fill(0.0);
+        };
+        problem.h = [=](ConstraintResultRef res, VectorView x, VectorView p, VectorView c, ConstraintOptions opts)
+        {
+            res.val = Jx * x + Jp * p;
+            res.ddx = Jx;
+            res.ddp = Jp;
+            res.ddc.fill(0.0);
+        };
+        problem.v = [=](ConstraintResultRef res, VectorView x, VectorView p, VectorView c, ConstraintOptions opts)
+        {
+            res.val = Vpx * x + Vpp * p;
+            res.ddx = Vpx;
+            res.ddp = Vpp;
+            res.ddc.fill(0.0);
+        };
+        problem.Ax = data.Ax;
+        problem.Ap = data.Ap;
+        problem.b = data.Ax * ones(nx) + data.Ap * ones(np);
+        problem.xlower = constants(nx, -infinity());
+        problem.xupper = constants(nx, infinity());
+        problem.plower = constants(np, -infinity());
+        problem.pupper = constants(np, infinity());
+        problem.c = problem.b;
+        problem.bc = identity(ny, nc);
+
+        MasterState state(dims);
+        state.u.x.fill(1.0);
+        state.u.p.fill(1.0);
+
+        ResidualFunction F;
+        F.initialize(problem);
+        F.updateOnlyJacobian(state.u);
+
+        SensitivitySolver sensitivitysolver;
+        sensitivitysolver.initialize(problem);
+
+        MasterSensitivity sensitivity(dims, nc);
+
+        benchPrint("SensitivitySolver::solve", "Nullspace", false, dims, benchMeasure([&] { sensitivitysolver.solve(F, state, sensitivity); }));
+    }
+}
@@ -0,0 +1,133 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+// Optima includes
+#include <Optima/Exception.hpp>
+#include <Optima/Optima.hpp>
+using namespace Optima;
+
+// Optima benchmark includes
+#include "BenchUtils.hpp"
+
+/// Return a Gibbs energy minimization problem with random coefficients.
+/// The problem is *min sum(x*(g + ln(x)))* subject to *Ax = b* and *x > 0*.
+/// If `withp` is true, it also has the nonlinear equality constraint
+/// *sum(x) - p = 0* and the external constraint *p - nx = 0*.
+auto createGibbsProblem(Index nx, Index ny, bool withp) -> Problem
+{
+    Dims dims;
+    dims.x = nx;
+    dims.be = ny;
+    dims.he = withp;
+    dims.p = withp;
+
+    const Vector g = random(nx);
+    const Matrix A = random(ny, nx).cwiseAbs();
+
+    Problem problem(dims);
+    problem.Aex = A;
+    problem.be = A * ones(nx);
+    problem.xlower = constants(nx, 1e-14);
+    problem.xupper = constants(nx, infinity());
+    problem.f = [=](ObjectiveResultRef res, VectorView x, VectorView p, VectorView c, ObjectiveOptions opts)
+    {
+        res.f = (x.array() * (g.array() + x.array().log())).sum();
+        res.fx = g.array() + x.array().log() + 1.0;
+        res.fxx = diag(inv(x));
+        res.diagfxx = true;
+    };
+
+    if(withp)
+    {
+        problem.he = [=](ConstraintResultRef res, VectorView x, VectorView p, VectorView c, ConstraintOptions opts)
+        {
+            res.val[0] = x.sum() - p[0];
+            res.ddx.fill(1.0);
+            res.ddp.fill(-1.0);
+        };
+        problem.v = [=](ConstraintResultRef res, VectorView x, VectorView p, VectorView c, ConstraintOptions opts)
+        {
+            res.val[0] = p[0] - nx;
+            res.ddx.fill(0.0);
+            res.ddp.fill(1.0);
+        };
+        problem.plower.fill(-infinity());
+        problem.pupper.fill(infinity());
+    }
+
+    return problem;
+}
+
+int main(int argc, char **argv)
+{
+    benchPrintHeader();
+
+    const auto methods = {
+        LinearSolverMethod::Fullspace,
+        LinearSolverMethod::Nullspace,
+        LinearSolverMethod::Rangespace,
+        LinearSolverMethod::Sparse,
+        LinearSolverMethod::Iterative,
+        LinearSolverMethod::Automatic };
+
+    for(auto nx : benchSizes(benchMaxSize(argc, argv)))
+    {
+        for(auto withp : {false, true})
+        {
+            const auto ny = nx/10 + 1;
+            const auto np = withp ? 1 : 0;
+            const auto nz = withp ? 1 : 0;
+
+            const MasterDims dims(nx, np, ny, nz);
+
+            const Problem problem = createGibbsProblem(nx, ny, withp);
+
+            for(auto method : methods)
+            for(auto mixed : {false, true})
+            {
+                if(mixed && method != LinearSolverMethod::Fullspace && method != LinearSolverMethod::Nullspace)
+                    continue; // the single-precision decomposition is only applicable to methods Fullspace and Nullspace
+
+                Options options;
+                options.newtonstep.linearsolver.method = method;
+                options.newtonstep.linearsolver.mixedprecision = mixed;
+
+                Solver solver;
+                solver.setOptions(options);
+
+                State state(problem.dims);
+
+                const auto name = benchMethodName(method) + (mixed ? "+mixedprecision" : "");
+
+                const auto timing = benchMeasure([&]
+                {
+                    state.x.fill(1.0);
+                    state.p.fill(1.0);
+                    state.ye.fill(0.0);
+                    state.yg.fill(0.0);
+                    state.ze.fill(0.0);
+                    state.zg.fill(0.0);
+                    const auto result = solver.solve(problem, state);
+                    errorif(!result.succeeded, "Solver::solve failed for nx = ", nx, " with method ", name, ".");
+                });
+
+                benchPrint("Solver::solve", name, true, dims, timing);
+            }
+        }
+    }
+}
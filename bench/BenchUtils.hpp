@@ -0,0 +1,197 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+// C++ includes
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Optima includes
+#include <Optima/EchelonizerW.hpp>
+#include <Optima/LinearSolverOptions.hpp>
+#include <Optima/MasterDims.hpp>
+#include <Optima/MasterMatrix.hpp>
+#include <Optima/Matrix.hpp>
+#include <Optima/StablePartition.hpp>
+#include <Optima/Timing.hpp>
+#include <Optima/Utils.hpp>
+
+namespace Optima {
+
+//======================================================================
+// Note: The benchmark applications print one line per measurement in CSV
+// format with columns:
+//
+//     benchmark,method,diagHxx,nx,np,ny,nz,samples,mean,min
+//
+// where mean and min are the mean and minimum wall times (in seconds) of
+// the measured operation. The largest number of variables nx in the sweep
+// (default 5000) can be given as the first command line argument.
+//======================================================================
+
+/// The wall times collected in a benchmark measurement.
+struct BenchTiming
+{
+    Index samples = 0; ///< The number of times the operation was executed.
+    double mean = 0;   ///< The mean wall time of the operation (in unit of s).
+    double min = 0;    ///< The minimum wall time of the operation (in unit of s).
+};
+
+/// Return the largest number of variables *x* given as the first command line argument (default 5000).
+inline auto benchMaxSize(int argc, char** argv) -> Index
+{
+    return argc > 1 ? std::atol(argv[1]) : 5000;
+}
+
+/// Return the sizes 10, 20, 50, ..., 5000 that do not exceed a given maximum.
+inline auto benchSizes(Index maxsize) -> std::vector<Index>
+{
+    std::vector<Index> sizes;
+    for(auto n : {10, 20, 50, 100, 200, 500, 1000, 2000, 5000})
+        if(n <= maxsize)
+            sizes.push_back(n);
+    return sizes;
+}
+
+/// Return the dimensions of the master variables swept in the benchmarks.
+/// For every number of variables *x*, a problem with only linear equality
+/// constraints and another with also nonlinear equality constraints and
+/// unknown parameters *p* are considered.
+inline auto benchDims(Index maxnx) -> std::vector<MasterDims>
+{
+    std::vector<MasterDims> dims;
+    for(auto nx : benchSizes(maxnx))
+    {
+        dims.push_back(MasterDims(nx, 0, nx/10 + 1, 0));
+        if(nx >= 20)
+            dims.push_back(MasterDims(nx, nx/20, nx/5, nx/20));
+    }
+    return dims;
+}
+
+/// Return the name of a linear solver method.
+inline auto benchMethodName(LinearSolverMethod method) -> std::string
+{
+    switch(method)
+    {
+        case LinearSolverMethod::Fullspace: return "Fullspace";
+        case LinearSolverMethod::Nullspace: return "Nullspace";
+        case LinearSolverMethod::Rangespace: return "Rangespace";
+        case LinearSolverMethod::Sparse: return "Sparse";
+        case LinearSolverMethod::Iterative: return "Iterative";
+        case LinearSolverMethod::Automatic: return "Automatic";
+    }
+    return "";
+}
+
+/// Measure the wall time of an operation by executing it several times.
+/// The operation is executed at least three times (once if it takes more
+/// than one second) and until half a second has elapsed in total.
+template<typename Operation>
+auto benchMeasure(Operation&& operation) -> BenchTiming
+{
+    BenchTiming timing;
+    timing.min = infinity();
+    double total = 0.0;
+    while(timing.samples < 1000)
+    {
+        const auto begin = timenow();
+        operation();
+        const auto time = elapsed(begin);
+        total += time;
+        timing.min = std::min(timing.min, time);
+        timing.samples += 1;
+        if(timing.samples == 1 && time > 1.0) break;
+        if(timing.samples >= 3 && total > 0.5) break;
+    }
+    timing.mean = total / timing.samples;
+    return timing;
+}
+
+/// Print the header line of the CSV output of the benchmarks.
+inline auto benchPrintHeader() -> void
+{
+    std::cout << "benchmark,method,diagHxx,nx,np,ny,nz,samples,mean,min" << std::endl;
+}
+
+/// Print a line in the CSV output of the benchmarks.
+inline auto benchPrint(const std::string& benchmark, const std::string& method, bool diagHxx, const MasterDims& dims, const BenchTiming& timing) -> void
+{
+    std::cout << benchmark << "," << method << "," << diagHxx << ","
+              << dims.nx << "," << dims.np << "," << dims.ny << "," << dims.nz << ","
+              << timing.samples << "," << timing.mean << "," << timing.min << std::endl;
+}
+
+/// Used to create and hold the data of a random master matrix.
+/// The Hessian matrix *Hxx* is positive definite, and it is diagonal if
+/// `diagHxx` is true, as needed by the Rangespace method.
+struct BenchMasterMatrix
+{
+    MasterDims dims;           ///< The dimensions of the master variables.
+    bool diagHxx;              ///< The flag indicating whether *Hxx* is diagonal.
+    Matrix Hxx;                ///< The matrix *Hxx* in *H = [Hxx Hxp]*.
+    Matrix Hxp;                ///< The matrix *Hxp* in *H = [Hxx Hxp]*.
+    Matrix Vpx;                ///< The matrix *Vpx* in *V = [Vpx Vpp]*.
+    Matrix Vpp;                ///< The matrix *Vpp* in *V = [Vpx Vpp]*.
+    Matrix Ax;                 ///< The matrix *Ax* in *W = [Ax Ap; Jx Jp]*.
+    Matrix Ap;                 ///< The matrix *Ap* in *W = [Ax Ap; Jx Jp]*.
+    Matrix Jx;                 ///< The matrix *Jx* in *W = [Ax Ap; Jx Jp]*.
+    Matrix Jp;                 ///< The matrix *Jp* in *W = [Ax Ap; Jx Jp]*.
+    Matrix Wx;                 ///< The matrix *Wx = [Ax; Jx]*.
+    Matrix Wp;                 ///< The matrix *Wp = [Ap; Jp]*.
+    Vector weights;            ///< The priority weights for the selection of basic variables.
+    EchelonizerW echelonizerW; ///< The echelonizer of matrix *W*.
+    StablePartition jsu;       ///< The partition of the variables *x* into stable and unstable ones.
+
+    /// Construct a BenchMasterMatrix object with given dimensions.
+    BenchMasterMatrix(const MasterDims& dims, bool diagHxx)
+    : dims(dims), diagHxx(diagHxx), jsu(dims.nx)
+    {
+        const auto [nx, np, ny, nz, nw, nt] = dims;
+
+        Hxx = diagHxx ? Matrix(diag(random(nx).cwiseAbs() + ones(nx))) : Matrix(random(nx, nx));
+        if(!diagHxx) Hxx = tr(Hxx) * Hxx + nx * identity(nx, nx);
+        Hxp = random(nx, np);
+        Vpx = random(np, nx);
+        Vpp = random(np, np);
+        Ax = random(ny, nx);
+        Ap = random(ny, np);
+        Jx = random(nz, nx);
+        Jp = random(nz, np);
+        Wx.resize(nw, nx);
+        Wp.resize(nw, np);
+        Wx << Ax, Jx;
+        Wp << Ap, Jp;
+        weights = random(nx).cwiseAbs();
+
+        echelonizerW.initialize(dims, Ax, Ap);
+        echelonizerW.update(Jx, Jp, weights);
+    }
+
+    /// Return the master matrix with the data in this object.
+    auto matrix() const -> MasterMatrix
+    {
+        return { dims, { Hxx, Hxp, diagHxx }, { Vpx, Vpp }, { Wx, Wp, Ax, Ap, Jx, Jp }, echelonizerW.RWQ(), jsu.stable(), jsu.unstable() };
+    }
+};
+
+} // namespace Optima
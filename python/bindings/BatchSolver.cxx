@@ -0,0 +1,91 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include <pybind11/pybind11.h>
+#include <pybind11/eigen.h>
+#include <pybind11/stl.h>
+namespace py = pybind11;
+
+// Optima includes
+#include <Optima/BatchSolver.hpp>
+#include <Optima/Options.hpp>
+#include <Optima/Problem.hpp>
+#include <Optima/Result.hpp>
+#include <Optima/Sensitivity.hpp>
+#include <Optima/State.hpp>
+using namespace Optima;
+
+void exportBatchSolver(py::module& m)
+{
+    // The State and Sensitivity objects in the given Python lists are updated in place, as in Solver.solve.
+    // The GIL is released during the batch calculation, so that the worker threads can acquire it whenever
+    // they evaluate objective and constraint functions defined in Python.
+
+    auto solve = [](BatchSolver& self, const std::vector<Problem>& problems, py::list states) -> std::vector<Result>
+    {
+        std::vector<State> cstates;
+        for(auto state : states)
+            cstates.push_back(state.cast<const State&>());
+
+        std::vector<Result> results;
+        {
+            py::gil_scoped_release release;
+            results = self.solve(problems, cstates);
+        }
+
+        for(std::size_t i = 0; i < cstates.size(); ++i)
+            states[i].cast<State&>() = cstates[i];
+
+        return results;
+    };
+
+    auto solveWithSensitivity = [](BatchSolver& self, const std::vector<Problem>& problems, py::list states, py::list sensitivities) -> std::vector<Result>
+    {
+        std::vector<State> cstates;
+        for(auto state : states)
+            cstates.push_back(state.cast<const State&>());
+
+        std::vector<Sensitivity> csensitivities;
+        for(auto sensitivity : sensitivities)
+            csensitivities.push_back(sensitivity.cast<const Sensitivity&>());
+
+        std::vector<Result> results;
+        {
+            py::gil_scoped_release release;
+            results = self.solve(problems, cstates, csensitivities);
+        }
+
+        for(std::size_t i = 0; i < cstates.size(); ++i)
+            states[i].cast<State&>() = cstates[i];
+
+        for(std::size_t i = 0; i < csensitivities.size(); ++i)
+            if(i < sensitivities.size()) sensitivities[i].cast<Sensitivity&>() = csensitivities[i];
+            else sensitivities.append(csensitivities[i]);
+
+        return results;
+    };
+
+    py::class_<BatchSolver>(m, "BatchSolver")
+        .def(py::init<>())
+        .def(py::init<Index>())
+        .def("setOptions", &BatchSolver::setOptions)
+        .def("numThreads", &BatchSolver::numThreads)
+        .def("solve", solve)
+        .def("solve", solveWithSensitivity)
+        ;
+}
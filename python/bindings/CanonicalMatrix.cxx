@@ -40,5 +40,6 @@ void exportCanonicalMatrix(py::module& m)
         .def_readonly("jn"   , &CanonicalMatrix::jn)
         .def_readonly("js"   , &CanonicalMatrix::js)
         .def_readonly("ju"   , &CanonicalMatrix::ju)
+        .def_readonly("isHssDiag", &CanonicalMatrix::isHssDiag)
         ;
 }
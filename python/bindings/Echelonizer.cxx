@@ -36,6 +36,11 @@ void exportEchelonizer(py::module& m)
         return self.compute(A);
     };
 
+    auto computeWithBasicVariables = [](Echelonizer& self, MatrixView4py A, IndicesView ibasic)
+    {
+        return self.computeWithBasicVariables(A, ibasic);
+    };
+
     py::class_<Echelonizer>(m, "Echelonizer")
         .def(py::init<>())
         .def(py::init<const Echelonizer&>())
@@ -47,11 +52,13 @@ void exportEchelonizer(py::module& m)
         .def("S", &Echelonizer::S, py::return_value_policy::reference_internal)
         .def("R", &Echelonizer::R, py::return_value_policy::reference_internal)
         .def("Q", &Echelonizer::Q, py::return_value_policy::reference_internal)
+        .def("isExact", &Echelonizer::isExact)
         .def("C", &Echelonizer::C)
         .def("indicesEquations", &Echelonizer::indicesEquations)
         .def("indicesBasicVariables", &Echelonizer::indicesBasicVariables, py::return_value_policy::reference_internal)
         .def("indicesNonBasicVariables", &Echelonizer::indicesNonBasicVariables, py::return_value_policy::reference_internal)
         .def("compute", compute)
+        .def("computeWithBasicVariables", computeWithBasicVariables)
         .def("updateWithSwapBasicVariable", &Echelonizer::updateWithSwapBasicVariable)
         .def("updateWithPriorityWeights", &Echelonizer::updateWithPriorityWeights)
         .def("updateOrdering", &Echelonizer::updateOrdering)
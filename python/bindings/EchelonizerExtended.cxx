@@ -31,6 +31,11 @@ void exportEchelonizerExtended(py::module& m)
         return EchelonizerExtended(A);
     };
 
+    auto initialize = [](EchelonizerExtended& self, MatrixView4py A)
+    {
+        return self.initialize(A);
+    };
+
     auto updateWithPriorityWeights = [](EchelonizerExtended& self, MatrixView4py J, VectorView weights)
     {
         return self.updateWithPriorityWeights(J, weights);
@@ -49,6 +54,8 @@ void exportEchelonizerExtended(py::module& m)
         .def("C", &EchelonizerExtended::C)
         .def("indicesBasicVariables", &EchelonizerExtended::indicesBasicVariables, py::return_value_policy::reference_internal)
         .def("indicesNonBasicVariables", &EchelonizerExtended::indicesNonBasicVariables, py::return_value_policy::reference_internal)
+        .def("initialize", initialize)
+        .def("reset", &EchelonizerExtended::reset)
         .def("updateWithPriorityWeights", updateWithPriorityWeights)
         .def("updateOrdering", &EchelonizerExtended::updateOrdering)
         .def("cleanResidualRoundoffErrors", &EchelonizerExtended::cleanResidualRoundoffErrors)
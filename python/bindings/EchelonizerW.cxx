@@ -42,6 +42,7 @@ void exportEchelonizerW(py::module& m)
     py::class_<EchelonizerW>(m, "EchelonizerW")
         .def(py::init<>())
         .def("initialize", initialize)
+        .def("reset", &EchelonizerW::reset)
         .def("update", update)
         .def("W", &EchelonizerW::W, PYBINDX_ENSURE_MUTUAL_EXISTENCE)
         .def("RWQ", &EchelonizerW::RWQ, PYBINDX_ENSURE_MUTUAL_EXISTENCE)
@@ -0,0 +1,53 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+// pybind11 includes
+#include <pybind11/pybind11.h>
+#include <pybind11/eigen.h>
+#include <pybind11/stl.h>
+namespace py = pybind11;
+
+// Optima includes
+#include <Optima/LDLT.hpp>
+using namespace Optima;
+
+void exportLDLT(py::module& m)
+{
+    auto decompose = [](LDLT& self, MatrixView4py A)
+    {
+        return self.decompose(A);
+    };
+
+    auto solve1 = [=](LDLT& self, VectorView b, VectorRef x) mutable
+    {
+        self.solve(b, x);
+    };
+
+    auto solve2 = [=](LDLT& self, VectorRef x) mutable
+    {
+        self.solve(x);
+    };
+
+    py::class_<LDLT>(m, "LDLT")
+        .def(py::init<>())
+        .def("empty", &LDLT::empty)
+        .def("decompose", decompose)
+        .def("solve", solve1)
+        .def("solve", solve2)
+        .def("inertia", &LDLT::inertia)
+        ;
+}
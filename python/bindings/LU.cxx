@@ -41,6 +41,26 @@ void exportLU(py::module& m)
         self.solve(x);
     };
 
+    // The right-hand sides are solved in a column-major copy since numpy arrays are row-major by default
+    auto solveMultiple1 = [=](LU& self, MatrixView4py B, MatrixRef4py X) mutable
+    {
+        Matrix Xw = B;
+        self.solveMultiple(Xw);
+        X = Xw;
+    };
+
+    auto solveMultiple2 = [=](LU& self, MatrixRef4py X) mutable
+    {
+        Matrix Xw = X;
+        self.solveMultiple(Xw);
+        X = Xw;
+    };
+
+    auto matrixLU = [=](LU& self) -> Matrix
+    {
+        return self.matrixLU();
+    };
+
     auto P = [=](LU& self) -> Indices
     {
         return self.P().indices().cast<Index>();
@@ -57,7 +77,10 @@ void exportLU(py::module& m)
         .def("decompose", decompose)
         .def("solve", solve1)
         .def("solve", solve2)
+        .def("solveMultiple", solveMultiple1)
+        .def("solveMultiple", solveMultiple2)
         .def("rank", &LU::rank)
+        .def("matrixLU", matrixLU)
         .def("P", P)
         .def("Q", Q)
         ;
@@ -33,5 +33,7 @@ void exportLinearSolver(py::module& m)
         .def("decompose", &LinearSolver::decompose)
         .def("solve", py::overload_cast<CanonicalMatrix, MasterVectorView, MasterVectorRef>(&LinearSolver::solve))
         .def("solve", py::overload_cast<CanonicalMatrix, CanonicalVectorView, MasterVectorRef>(&LinearSolver::solve))
+        .def("solveWithPreviousDecomposition", py::overload_cast<CanonicalMatrix, MasterVectorView, MasterVectorRef>(&LinearSolver::solveWithPreviousDecomposition))
+        .def("solveWithPreviousDecomposition", py::overload_cast<CanonicalMatrix, CanonicalVectorView, MasterVectorRef>(&LinearSolver::solveWithPreviousDecomposition))
         ;
 }
@@ -17,6 +17,8 @@
 
 // pybind11 includes
 #include <pybind11/pybind11.h>
+#include <pybind11/functional.h>
+#include <pybind11/eigen.h>
 namespace py = pybind11;
 
 // Optima includes
@@ -29,10 +31,25 @@ void exportLinearSolverOptions(py::module& m)
         .value("Fullspace", LinearSolverMethod::Fullspace)
         .value("Nullspace", LinearSolverMethod::Nullspace)
         .value("Rangespace", LinearSolverMethod::Rangespace)
+        .value("Sparse", LinearSolverMethod::Sparse)
+        .value("Iterative", LinearSolverMethod::Iterative)
+        .value("Automatic", LinearSolverMethod::Automatic)
+        ;
+
+    py::class_<LinearSolverIterativeOptions>(m, "LinearSolverIterativeOptions")
+        .def(py::init<>())
+        .def_readwrite("tolerance", &LinearSolverIterativeOptions::tolerance)
+        .def_readwrite("maxiters", &LinearSolverIterativeOptions::maxiters)
+        .def_readwrite("restart", &LinearSolverIterativeOptions::restart)
+        .def_readwrite("hessian", &LinearSolverIterativeOptions::hessian)
         ;
 
     py::class_<LinearSolverOptions>(m, "LinearSolverOptions")
         .def(py::init<>())
         .def_readwrite("method", &LinearSolverOptions::method)
+        .def_readwrite("calibrate", &LinearSolverOptions::calibrate)
+        .def_readwrite("cholesky", &LinearSolverOptions::cholesky)
+        .def_readwrite("mixedprecision", &LinearSolverOptions::mixedprecision)
+        .def_readwrite("iterative", &LinearSolverOptions::iterative)
         ;
 }
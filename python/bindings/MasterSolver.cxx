@@ -29,7 +29,10 @@ void exportMasterSolver(py::module& m)
     py::class_<MasterSolver>(m, "MasterSolver")
         .def(py::init<>())
         .def("setOptions", &MasterSolver::setOptions)
+        .def("initialize", &MasterSolver::initialize)
         .def("solve", py::overload_cast<const MasterProblem&, MasterState&>(&MasterSolver::solve))
         .def("solve", py::overload_cast<const MasterProblem&, MasterState&, MasterSensitivity&>(&MasterSolver::solve))
+        .def("resolve", py::overload_cast<const MasterProblem&, MasterState&>(&MasterSolver::resolve))
+        .def("resolve", py::overload_cast<const MasterProblem&, MasterState&, MasterSensitivity&>(&MasterSolver::resolve))
         ;
 }
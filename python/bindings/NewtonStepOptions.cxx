@@ -25,7 +25,15 @@ using namespace Optima;
 
 void exportNewtonStepOptions(py::module& m)
 {
+    py::class_<SimplifiedNewtonOptions>(m, "SimplifiedNewtonOptions")
+        .def(py::init<>())
+        .def_readwrite("active", &SimplifiedNewtonOptions::active)
+        .def_readwrite("contraction", &SimplifiedNewtonOptions::contraction)
+        .def_readwrite("maxreuses", &SimplifiedNewtonOptions::maxreuses)
+        ;
+
     py::class_<NewtonStepOptions>(m, "NewtonStepOptions")
         .def_readwrite("linearsolver", &NewtonStepOptions::linearsolver)
+        .def_readwrite("simplified", &NewtonStepOptions::simplified)
         ;
 }
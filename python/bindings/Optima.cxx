@@ -21,6 +21,7 @@ namespace py = pybind11;
 
 void exportEigen(py::module& m);
 void exportConstants(py::module& m);
+void exportBatchSolver(py::module& m);
 void exportCanonicalDims(py::module& m);
 void exportCanonicalizer(py::module& m);
 void exportCanonicalMatrix(py::module& m);
@@ -35,6 +36,7 @@ void exportIndexUtils(py::module& m);
 void exportLineSearchOptions(py::module& m);
 void exportLinearSolver(py::module& m);
 void exportLinearSolverOptions(py::module& m);
+void exportLDLT(py::module& m);
 void exportLU(py::module& m);
 void exportMasterDims(py::module& m);
 void exportMasterProblem(py::module& m);
@@ -48,6 +50,7 @@ void exportMatrixViewH(py::module& m);
 void exportMatrixViewRWQ(py::module& m);
 void exportMatrixViewV(py::module& m);
 void exportMatrixViewW(py::module& m);
+void exportMixedPrecisionLU(py::module& m);
 void exportNewtonStep(py::module& m);
 void exportNewtonStepOptions(py::module& m);
 void exportObjectiveFunction(py::module& m);
@@ -55,11 +58,13 @@ void exportOutputter(py::module& m);
 void exportOptions(py::module& m);
 void exportProblem(py::module& m);
 void exportResidualFunction(py::module& m);
+void exportResidualFunctionOptions(py::module& m);
 void exportResidualVector(py::module& m);
 void exportResult(py::module& m);
 void exportSensitivity(py::module& m);
 void exportSensitivitySolver(py::module& m);
 void exportSolver(py::module& m);
+void exportSolverSession(py::module& m);
 void exportStablePartition(py::module& m);
 void exportStability(py::module& m);
 void exportState(py::module& m);
@@ -70,6 +75,7 @@ PYBIND11_MODULE(optima4py, m)
 {
     exportEigen(m);
     exportConstants(m);
+    exportBatchSolver(m);
     exportCanonicalDims(m);
     exportCanonicalizer(m);
     exportCanonicalMatrix(m);
@@ -84,6 +90,7 @@ PYBIND11_MODULE(optima4py, m)
     exportLineSearchOptions(m);
     exportLinearSolver(m);
     exportLinearSolverOptions(m);
+    exportLDLT(m);
     exportLU(m);
     exportMasterDims(m);
     exportMasterProblem(m);
@@ -97,6 +104,7 @@ PYBIND11_MODULE(optima4py, m)
     exportMatrixViewRWQ(m);
     exportMatrixViewV(m);
     exportMatrixViewW(m);
+    exportMixedPrecisionLU(m);
     exportNewtonStep(m);
     exportNewtonStepOptions(m);
     exportObjectiveFunction(m);
@@ -104,11 +112,13 @@ PYBIND11_MODULE(optima4py, m)
     exportOptions(m);
     exportProblem(m);
     exportResidualFunction(m);
+    exportResidualFunctionOptions(m);
     exportResidualVector(m);
     exportResult(m);
     exportSensitivity(m);
     exportSensitivitySolver(m);
     exportSolver(m);
+    exportSolverSession(m);
     exportStablePartition(m);
     exportStability(m);
     exportState(m);
@@ -58,6 +58,7 @@ void exportOptions(py::module& m)
         .def_readwrite("steepestdescent", &Options::steepestdescent)
         .def_readwrite("backtrack", &Options::backtrack)
         .def_readwrite("newtonstep", &Options::newtonstep)
+        .def_readwrite("residualfunction", &Options::residualfunction)
         .def_readwrite("convergence", &Options::convergence)
         ;
 }
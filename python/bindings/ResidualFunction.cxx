@@ -48,7 +48,9 @@ void exportResidualFunction(py::module& m)
 
     py::class_<ResidualFunction>(m, "ResidualFunction")
         .def(py::init<>())
+        .def("setOptions"                  , &ResidualFunction::setOptions)
         .def("initialize"                  , &ResidualFunction::initialize)
+        .def("reinitialize"                , &ResidualFunction::reinitialize)
         .def("update"                      , &ResidualFunction::update)
         .def("updateSkipJacobian"          , &ResidualFunction::updateSkipJacobian)
         .def("updateOnlyJacobian"          , &ResidualFunction::updateOnlyJacobian)
@@ -39,6 +39,12 @@ void exportResult(py::module& m)
         .def_readwrite("num_objective_evals_fx", &Result::num_objective_evals_fx)
         .def_readwrite("num_objective_evals_fxx", &Result::num_objective_evals_fxx)
         .def_readwrite("num_objective_evals_fxp", &Result::num_objective_evals_fxp)
+        .def_readwrite("num_constraint_evals_h", &Result::num_constraint_evals_h)
+        .def_readwrite("num_constraint_evals_hx", &Result::num_constraint_evals_hx)
+        .def_readwrite("num_constraint_evals_hp", &Result::num_constraint_evals_hp)
+        .def_readwrite("num_constraint_evals_v", &Result::num_constraint_evals_v)
+        .def_readwrite("num_constraint_evals_vx", &Result::num_constraint_evals_vx)
+        .def_readwrite("num_constraint_evals_vp", &Result::num_constraint_evals_vp)
         .def_readwrite("time", &Result::time)
         .def_readwrite("time_objective_evals", &Result::time_objective_evals)
         .def_readwrite("time_objective_evals_f", &Result::time_objective_evals_f)
@@ -46,6 +52,9 @@ void exportResult(py::module& m)
         .def_readwrite("time_objective_evals_fxx", &Result::time_objective_evals_fxx)
         .def_readwrite("time_objective_evals_fxp", &Result::time_objective_evals_fxp)
         .def_readwrite("time_constraint_evals", &Result::time_constraint_evals)
+        .def_readwrite("time_echelonization", &Result::time_echelonization)
+        .def_readwrite("time_stability", &Result::time_stability)
+        .def_readwrite("time_canonicalization", &Result::time_canonicalization)
         .def_readwrite("time_linear_systems", &Result::time_linear_systems)
         .def_readwrite("time_sensitivities", &Result::time_sensitivities)
         .def(py::self += py::self, py::return_value_policy::reference_internal)
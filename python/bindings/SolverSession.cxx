@@ -0,0 +1,50 @@
+// Optima is a C++ library for solving linear and non-linear constrained optimization problems
+//
+// Copyright (C) 2020 Allan Leal
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+// pybind11 includes
+#include <pybind11/pybind11.h>
+#include <pybind11/eigen.h>
+namespace py = pybind11;
+
+// Optima includes
+#include <Optima/Options.hpp>
+#include <Optima/Problem.hpp>
+#include <Optima/Result.hpp>
+#include <Optima/Sensitivity.hpp>
+#include <Optima/SolverSession.hpp>
+#include <Optima/State.hpp>
+using namespace Optima;
+
+void exportSolverSession(py::module& m)
+{
+    py::class_<SolverSession>(m, "SolverSession")
+        .def(py::init<>())
+        .def(py::init<const Problem&>())
+        .def("initialize", &SolverSession::initialize)
+        .def("setOptions", &SolverSession::setOptions)
+        .def("setbe", &SolverSession::setbe)
+        .def("setbg", &SolverSession::setbg)
+        .def("setc", &SolverSession::setc)
+        .def("setxlower", &SolverSession::setxlower)
+        .def("setxupper", &SolverSession::setxupper)
+        .def("setplower", &SolverSession::setplower)
+        .def("setpupper", &SolverSession::setpupper)
+        .def("solve", py::overload_cast<State&>(&SolverSession::solve))
+        .def("solve", py::overload_cast<State&, Sensitivity&>(&SolverSession::solve))
+        ;
+}
@@ -34,4 +34,6 @@ void exportTiming(py::module& m)
     m.def("timenow", &timenow);
     m.def("elapsed", (double(*)(const Time&, const Time&)) &elapsed);
     m.def("elapsed", (double(*)(const Time&)) &elapsed);
+
+    m.attr("PROFILING") = py::bool_(PROFILING);
 }
@@ -0,0 +1,130 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright (C) 2020 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+from testing.optima import *
+from testing.utils.matrices import *
+from numpy import *
+
+
+@pytest.mark.parametrize("nx"        , [10, 20, 50])
+@pytest.mark.parametrize("withp"     , [False, True])
+@pytest.mark.parametrize("numthreads", [1, 4])
+def testBatchSolver(nx, withp, numthreads):
+
+    # A batch of Gibbs energy minimization problems min sum(x*(g + ln(x)))
+    # subject to Ax = b and x > 0, and also sum(x) - p = 0 and p - nx = 0 if
+    # withp is true, which differ in their vectors g and b
+    ny = nx//10 + 1
+    np = 1 if withp else 0
+    nz = np
+
+    numproblems = 10
+
+    A = random.rand(ny, nx)
+
+    def createProblem(g, be):
+
+        def objectivefn_f(res, x, p, c, opts):
+            res.f   = sum(x * (g + log(x)))
+            res.fx  = g + log(x) + 1.0
+            res.fxx = diag(1.0/x)
+            res.diagfxx = True
+
+        def constraintfn_h(res, x, p, c, opts):
+            res.val = array([sum(x) - p[0]])
+            res.ddx = ones((1, nx))
+            res.ddp = -ones((1, 1))
+
+        def constraintfn_v(res, x, p, c, opts):
+            res.val = array([p[0] - nx])
+            res.ddx = zeros((1, nx))
+            res.ddp = ones((1, 1))
+
+        dims = Dims()
+        dims.x  = nx
+        dims.p  = np
+        dims.be = ny
+        dims.he = nz
+
+        problem = Problem(dims)
+        problem.f = objectivefn_f
+        problem.Aex = A
+        problem.be = be
+        problem.xlower = full(nx, 1e-14)
+        problem.xupper = full(nx, inf)
+
+        if withp:
+            problem.he = constraintfn_h
+            problem.v = constraintfn_v
+            problem.plower = full(np, -inf)
+            problem.pupper = full(np,  inf)
+
+        return problem
+
+    def createState(dims):
+        state = State(dims)
+        state.x = ones(nx)
+        state.p = ones(np)
+        return state
+
+    def createFeasiblePoint():
+        x = ones(nx) + random.rand(nx)
+        return x * nx / sum(x)  # ensure sum(x) = nx so that the problems with p are feasible
+
+    problems = [createProblem(random.rand(nx), A @ createFeasiblePoint()) for i in range(numproblems)]
+
+    options = Options()
+
+    # Solve the problems sequentially with a single Solver
+    solver = Solver()
+    solver.setOptions(options)
+
+    expected = [createState(problem.dims) for problem in problems]
+
+    for problem, state in zip(problems, expected):
+        res = solver.solve(problem, state)
+        assert res.succeeded
+
+    # Check the batch of problems solved by several threads produces the same states
+    batchsolver = BatchSolver(numthreads)
+    batchsolver.setOptions(options)
+
+    assert batchsolver.numThreads() == numthreads
+
+    states = [createState(problem.dims) for problem in problems]
+
+    results = batchsolver.solve(problems, states)
+
+    assert len(results) == numproblems
+
+    for res, state, expectedstate in zip(results, states, expected):
+        assert res.succeeded
+        assert_array_almost_equal(state.x, expectedstate.x)
+        assert_array_almost_equal(state.p, expectedstate.p)
+        assert_array_almost_equal(state.ye, expectedstate.ye)
+
+    # Check the batch of problems is solved again, now also with sensitivity derivatives
+    states = [createState(problem.dims) for problem in problems]
+
+    sensitivities = [Sensitivity() for problem in problems]
+
+    results = batchsolver.solve(problems, states, sensitivities)
+
+    for res, state, expectedstate in zip(results, states, expected):
+        assert res.succeeded
+        assert_array_almost_equal(state.x, expectedstate.x)
@@ -157,3 +157,17 @@ def testCanonicalizer(nx, np, ny, nz, nl, nu, diagHxx):
     assert dims.nbi == nbi
     assert dims.nne == nne
     assert dims.nni == nni
+
+    #==========================================================================
+    # Check Hss is updated correctly when only the entries in Hxx change
+    #==========================================================================
+    H = MatrixViewH(2.0 * H.Hxx, H.Hxp, diagHxx)
+    M = MasterMatrix(M.dims, H, V, W, RWQ, M.js, M.ju)
+
+    canonicalizer.update(M)
+
+    Mc = canonicalizer.canonicalMatrix()
+
+    js = Mc.js
+
+    assert npy.all(Mc.Hss == H.Hxx[:, js][js, :])
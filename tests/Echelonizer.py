@@ -85,6 +85,21 @@ def check_new_ordering(echelonizer, Kb, Kn):
     assert_array_almost_equal(Qnew[nb:],  Q[nb:][Kn])
 
 
+def sparse_formula_matrix(rng, m, n, rank_deficient):
+    # Create a formula-like matrix with 1 to 3 non-zero entries per column, which are not integers so that
+    # the echelon form is computed with floating-point arithmetic, and optionally with a linearly dependent row
+    A = npy.zeros((m, n))
+    for j in range(n):
+        rows = rng.randint(0, m, size=rng.randint(1, 4))
+        A[rows, j] = rng.uniform(0.1, 3.0, size=len(rows))
+    for i in range(min(m, n)):
+        if not A[i, :].any():
+            A[i, i] = rng.uniform(0.1, 3.0)
+    if rank_deficient:
+        A[m - 1, :] = A[0, :] + 0.5 * A[1, :]
+    return A
+
+
 def check_echelonizer(echelonizer, A):
     # Auxiliary variables
     n = echelonizer.numVariables()
@@ -181,3 +196,228 @@ def testEchelonizer(n, m, assembleA, jfixed):
     Qnew = npy.copy(echelonizer.Q())
 
     assert not npy.array_equal(R, Rnew)
+
+
+@pytest.mark.parametrize("n", tested_n)
+@pytest.mark.parametrize("m", tested_m)
+def testEchelonizerExact(n, m):
+
+    # Create a formula-like matrix with small integer coefficients and one linearly dependent row
+    rng = npy.random.RandomState(m*n)
+    A = npy.zeros((m, n))
+    for j in range(n):
+        A[rng.randint(0, m, size=3), j] = rng.randint(1, 4, size=3)
+    for i in range(min(m, n)):
+        A[i, i] += 1
+    A[2, :] = 2*A[0, :] + A[1, :]
+
+    echelonizer = Echelonizer(A)
+
+    assert echelonizer.isExact()
+
+    check_echelonizer(echelonizer, A)
+
+    # Check that basis swaps without cleanup or reset accumulate no round-off errors
+    echelonizer.reset()
+
+    nb = echelonizer.numBasicVariables()
+    nn = echelonizer.numNonBasicVariables()
+
+    for k in range(10*nb if nn > 0 else 0):
+        i, j = k % nb, (7*k) % nn
+        if echelonizer.S()[i, j] != 0.0:
+            echelonizer.updateWithSwapBasicVariable(i, j)
+
+    assert echelonizer.isExact()
+
+    R = echelonizer.R()
+    Q = echelonizer.Q()
+    C = echelonizer.C()
+
+    Cstar = R @ A[:, Q]
+
+    assert npy.max(npy.abs(Cstar[:nb, :] - C[:nb, :])) < 1e-12
+
+    # Check that the exact arithmetic is not used for non-integer matrices
+    assert not Echelonizer(A + 0.5).isExact()
+
+
+@pytest.mark.parametrize("n", tested_n)
+@pytest.mark.parametrize("m", tested_m)
+def testEchelonizerWithBasicVariables(n, m):
+
+    # Skip tests in which there are more rows than columns
+    if m > n: return
+
+    rng = npy.random.RandomState(m*n)
+    A = rng.rand(m, n)
+
+    echelonizer = Echelonizer(A)
+    echelonizer.updateWithPriorityWeights(rng.rand(n))
+
+    ibasic = npy.copy(echelonizer.indicesBasicVariables())
+
+    # Check the basic variables are reused for a slightly changed matrix
+    A = A + 1e-3 * rng.rand(m, n)
+
+    echelonizer.computeWithBasicVariables(A, ibasic)
+
+    assert not echelonizer.isExact()
+    assert npy.array_equal(echelonizer.indicesBasicVariables(), ibasic)
+
+    check_echelonizer(echelonizer, A)
+
+    # Check the canonical form is computed as usual when the columns of the basic variables are linearly dependent
+    A[:, ibasic[-1]] = A[:, ibasic[0]]
+
+    echelonizer.computeWithBasicVariables(A, ibasic)
+
+    check_canonical_form(echelonizer, A)
+
+
+@pytest.mark.parametrize("n", tested_n)
+@pytest.mark.parametrize("m", tested_m)
+def testEchelonizerRoundoffErrors(n, m):
+
+    # Skip tests in which there are more rows than columns
+    if m >= n: return
+
+    rng = npy.random.RandomState(m*n)
+    A = rng.rand(m, n)
+
+    echelonizer = Echelonizer(A)
+
+    nb = echelonizer.numBasicVariables()
+    nn = echelonizer.numNonBasicVariables()
+
+    # Check that many basis swaps without reset keep the canonical form accurate
+    for k in range(100*nb):
+        i, j = rng.randint(nb), rng.randint(nn)
+        if abs(echelonizer.S()[i, j]) > 0.1:
+            echelonizer.updateWithSwapBasicVariable(i, j)
+
+    check_canonical_form(echelonizer, A)
+
+    # Check that a second cleanup without changes in between leaves the canonical form unchanged
+    echelonizer.cleanResidualRoundoffErrors()
+
+    R = npy.copy(echelonizer.R())
+    S = npy.copy(echelonizer.S())
+
+    echelonizer.cleanResidualRoundoffErrors()
+
+    assert npy.array_equal(R, echelonizer.R())
+    assert npy.array_equal(S, echelonizer.S())
+
+
+@pytest.mark.parametrize("n", tested_n)
+@pytest.mark.parametrize("m", tested_m)
+@pytest.mark.parametrize("sparse", [False, True])
+def testEchelonizerPriorityWeightsSwaps(n, m, sparse):
+
+    # Skip tests in which there are more rows than columns
+    if m >= n: return
+
+    rng = npy.random.RandomState(m*n)
+    A = sparse_formula_matrix(rng, m, n, False) if sparse else rng.rand(m, n)
+
+    echelonizer = Echelonizer(A)
+
+    nb = echelonizer.numBasicVariables()
+    nn = echelonizer.numNonBasicVariables()
+
+    # The threshold used in Echelonizer to compare the entries in S
+    threshold = npy.max(npy.abs(A)) * npy.finfo(float).eps * min(m, n) * max(m, n)
+
+    # Check the swaps of many consecutive updates with random weights are the same as those of sequential basis swaps
+    for k in range(10):
+        weights = rng.rand(n)
+
+        expected = Echelonizer(echelonizer)
+
+        echelonizer.updateWithPriorityWeights(weights)
+
+        check_canonical_form(echelonizer, A)
+        check_canonical_ordering(echelonizer, weights)
+
+        # Swap each basic variable by the non-basic variable with maximum weight, greater than its own, among those
+        # with entry in the current row of S greater than the threshold and not negligible compared with the row
+        for i in range(nb):
+            ibasic = expected.indicesBasicVariables()
+            inonbasic = expected.indicesNonBasicVariables()
+            S = expected.S()
+            tol = max(threshold, 1e-8 * npy.max(npy.abs(S[i, :])))
+            candidates = [j for j in range(nn) if weights[inonbasic[j]] > weights[ibasic[i]] and abs(S[i, j]) > tol]
+            if candidates:
+                j = max(candidates, key=lambda j: weights[inonbasic[j]])
+                expected.updateWithSwapBasicVariable(i, j)
+
+        ibasic = list(expected.indicesBasicVariables())
+        inonbasic = list(expected.indicesNonBasicVariables())
+
+        Kb = [ibasic.index(j) for j in echelonizer.indicesBasicVariables()]
+        Kn = [inonbasic.index(j) for j in echelonizer.indicesNonBasicVariables()]
+
+        expected.updateOrdering(Kb, Kn)
+
+        assert_array_equal(echelonizer.Q(), expected.Q())
+        assert_array_almost_equal(echelonizer.R(), expected.R())
+        assert_array_almost_equal(echelonizer.S(), expected.S())
+
+
+@pytest.mark.parametrize("n", tested_n)
+@pytest.mark.parametrize("m", tested_m)
+@pytest.mark.parametrize("ties", [False, True])
+def testEchelonizerPriorityWeightsUnchanged(n, m, ties):
+
+    rng = npy.random.RandomState(m*n)
+    A = rng.rand(m, n)
+
+    # The weights have many ties if requested, so that the order of tied variables is also checked
+    weights = npy.floor(4*rng.rand(n)) if ties else rng.rand(n)
+
+    echelonizer = Echelonizer(A)
+    echelonizer.updateWithPriorityWeights(weights)
+
+    R = npy.copy(echelonizer.R())
+    S = npy.copy(echelonizer.S())
+    Q = npy.copy(echelonizer.Q())
+
+    # Check the canonical form is left unchanged by weights in the same order as before
+    for scale in [1.0, 2.0]:
+        echelonizer.updateWithPriorityWeights(scale * weights)
+
+        assert npy.array_equal(R, echelonizer.R())
+        assert npy.array_equal(S, echelonizer.S())
+        assert npy.array_equal(Q, echelonizer.Q())
+
+    check_canonical_form(echelonizer, A)
+    check_canonical_ordering(echelonizer, weights)
+
+
+@pytest.mark.parametrize("n", [30, 55])
+@pytest.mark.parametrize("m", [5, 8])
+@pytest.mark.parametrize("rank_deficient", [False, True])
+def testEchelonizerRoundoffErrorsSparse(n, m, rank_deficient):
+
+    for trial in range(20):
+        rng = npy.random.RandomState(trial)
+        A = sparse_formula_matrix(rng, m, n, rank_deficient)
+
+        echelonizer = Echelonizer(A)
+
+        assert not echelonizer.isExact()
+
+        if rank_deficient:
+            assert echelonizer.numBasicVariables() < m
+
+        # Check that many updates with random weights keep the canonical form accurate, also when the
+        # accumulated round-off errors cannot be removed by computing R and S again from A (e.g., because
+        # A has linearly dependent rows), in which case the swaps are replayed from the initial canonical form
+        for k in range(10):
+            weights = rng.rand(n)
+
+            echelonizer.updateWithPriorityWeights(weights)
+
+            check_canonical_form(echelonizer, A)
+            check_canonical_ordering(echelonizer, weights)
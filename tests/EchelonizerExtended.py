@@ -165,3 +165,26 @@ def testEchelonizerExtended(nx, ny, nz, assembleA):
     echelonizer = EchelonizerExtended(A)
     echelonizer.cleanResidualRoundoffErrors()
     check_echelonizer(echelonizer, A, J)
+
+    #==========================================================================
+    # Check if EchelonizerExtended::initialize performs memoization correctly
+    #==========================================================================
+    echelonizer = EchelonizerExtended(A)
+
+    R = npy.copy(echelonizer.R())
+    S = npy.copy(echelonizer.S())
+    Q = npy.copy(echelonizer.Q())
+
+    weigths = npy.linspace(nx, 1, nx)
+    echelonizer.updateWithPriorityWeights(J, weigths)
+
+    echelonizer.initialize(A)  # use same A, then ensure R, S, Q are reset to those initially computed
+
+    assert npy.array_equal(R, echelonizer.R())
+    assert npy.array_equal(S, echelonizer.S())
+    assert npy.array_equal(Q, echelonizer.Q())
+
+    A = npy.ones((ny, nx))  # change A, then ensure R has changed accordingly
+    echelonizer.initialize(A)
+
+    assert not npy.array_equal(R, echelonizer.R())
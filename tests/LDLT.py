@@ -0,0 +1,64 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright (C) 2020 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+from testing.optima import *
+from testing.utils.matrices import *
+
+
+# Tested number of primal variables x
+tested_nx = [10, 20, 40, 80]
+
+# Tested number of equality constraints
+tested_nw = [0, 1, 5, 10]
+
+
+@pytest.mark.parametrize("nx", tested_nx)
+@pytest.mark.parametrize("nw", tested_nw)
+def testLDLT(nx, nw):
+
+    n = nx + nw
+
+    # The symmetric indefinite saddle-point matrix A = [H W'; W 0]
+    H = matrix_non_singular(nx)
+    H = H @ H.T
+    W = npy.random.rand(nw, nx)
+
+    A = npy.zeros((n, n))
+    A[:nx, :nx] = H
+    A[:nx, nx:] = W.T
+    A[nx:, :nx] = W
+
+    x_expected = npy.linspace(1, n, n)
+    b = A @ x_expected
+
+    ldlt = LDLT()
+    assert ldlt.decompose(A)
+
+    x = npy.zeros(n)
+    ldlt.solve(b, x)
+
+    assert_allclose(A @ x, b)
+
+    # The matrix has nx positive and nw negative eigenvalues
+    assert ldlt.inertia() == [nx, nw, 0]
+
+    # A singular matrix is rejected by the decomposition
+    A[:, 0] = 0.0
+    A[0, :] = 0.0
+
+    assert not ldlt.decompose(A)
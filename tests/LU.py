@@ -56,3 +56,127 @@ def testLU(n, rank_deficiency):
         A[row, :] = row * A[0, :]
 
     check(A, x, rank_expected, linearly_dependent_rows)
+
+
+@pytest.mark.parametrize("n", tested_n)
+def testLUPivoting(n):
+
+    def check(A):
+        b = A @ npy.linspace(1, n, n)
+        x = npy.zeros(n)
+        lu.decompose(A)
+        lu.solve(b, x)
+
+        assert_allclose(A @ x, b)
+
+        # Check P*A*Q = L*U, where (P*A)[P[i], :] = A[i, :] and (A*Q)[:, j] = A[:, Q[j]]
+        M = lu.matrixLU()
+        L = npy.tril(M, -1) + npy.eye(n)
+        U = npy.triu(M)
+        PA = npy.zeros((n, n))
+        PA[lu.P()] = A
+        PAQ = PA[:, lu.Q()]
+
+        assert_allclose(PAQ, L @ U, atol=1e-13 * linalg.norm(A))
+
+        # Return true if the LU decomposition was computed with full pivoting
+        return not npy.array_equal(lu.Q(), npy.arange(n))
+
+    u, s, vh = linalg.svd(matrix_non_singular(n))
+
+    A = u @ npy.diag(npy.linspace(1.0, n, num=n)) @ vh         # a well-conditioned matrix
+    B = u @ npy.diag(npy.logspace(0.0, -12.0, num=n)) @ vh     # an ill-conditioned matrix with rcond ~ 1e-12
+
+    lu = LU()
+
+    assert not check(A)  # the well-conditioned matrix is decomposed with partial pivoting
+    assert check(B)      # the ill-conditioned matrix falls back to full pivoting
+    assert check(A)      # full pivoting is used again right after an ill-conditioned matrix
+    assert not check(A)  # partial pivoting is used again once the previous matrix was well-conditioned
+
+
+@pytest.mark.parametrize("n", tested_n)
+@pytest.mark.parametrize("rank_deficiency", tested_rank_deficiency)
+def testLUSolveMultiple(n, rank_deficiency):
+
+    linearly_dependent_rows = list(range(1, n, math.ceil(n / rank_deficiency))) \
+        if rank_deficiency != 0 else []
+
+    A = matrix_non_singular(n)
+
+    # Change the rows of A so that linearly dependent rows are produced
+    for row in linearly_dependent_rows:
+        A[row, :] = row * A[0, :]
+
+    k = 5
+
+    B = A @ npy.random.rand(n, k)
+
+    lu = LU()
+    lu.decompose(A)
+
+    X = npy.zeros((n, k))
+    lu.solveMultiple(B, X)
+
+    assert_allclose(A @ X, B)
+
+    # Check each column of X is the solution computed with a single right-hand side
+    for j in range(k):
+        x = npy.zeros(n)
+        lu.solve(B[:, j], x)
+        assert_allclose(X[:, j], x, atol=1e-12)
+
+    # Check the in-place solution with X = B as input
+    Y = B.copy()
+    lu.solveMultiple(Y)
+
+    assert_allclose(Y, X)
+
+
+@pytest.mark.parametrize("n", tested_n)
+def testLUSolveUpperDiscarding(n):
+
+    # The zero rows of A result in exactly zero pivots in U
+    zero_rows = [1, n // 2, n - 1]
+
+    A = matrix_non_singular(n)
+    A[zero_rows, :] = 0.0
+
+    # A right-hand side vector that is inconsistent in the zero rows of A
+    b = npy.linspace(1, n, n)
+
+    lu = LU()
+    lu.decompose(A)
+
+    x = npy.zeros(n)
+    lu.solve(b, x)
+
+    assert lu.rank() == n - len(zero_rows)
+
+    # Compute the expected solution by discarding the equations in U*z = y
+    # with a modified copy of U, where L*y = P*b and x = Q*z
+    M = lu.matrixLU()
+    L = npy.tril(M, -1) + npy.eye(n)
+    U = npy.triu(M)
+
+    Pb = npy.zeros(n)
+    Pb[lu.P()] = b
+    y = linalg.solve(L, Pb)
+
+    eps = npy.finfo(float).eps
+    discarded = npy.abs(npy.diag(U)) <= eps * npy.abs(y)
+
+    assert npy.count_nonzero(discarded) == len(zero_rows)
+
+    for i in npy.flatnonzero(discarded):
+        U[i, :] = 0.0
+        U[:, i] = 0.0
+        U[i, i] = 1.0
+        y[i] = 0.0
+
+    z = linalg.solve(U, y)
+
+    x_expected = npy.zeros(n)
+    x_expected[lu.Q()] = z
+
+    assert_allclose(x, x_expected, atol=1e-12)
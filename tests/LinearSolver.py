@@ -27,12 +27,17 @@ tested_nz      = [0, 5]         # The tested number of z variables
 tested_nl      = [0, 2]         # The tested number of linearly dependent rows in Ax
 tested_nu      = [0, 2]         # The tested number of unstable variables
 tested_diagHxx = [False, True]  # The tested options for Hxx structure
+tested_chol    = [False, True]  # The tested options for the Cholesky decomposition in method Nullspace
+tested_mixed   = [False, True]  # The tested options for the single-precision decomposition in methods Fullspace and Nullspace
 
 # Tested cases for the linear solver methods
 tested_methods = [
     LinearSolverMethod.Fullspace,
     LinearSolverMethod.Nullspace,
-    LinearSolverMethod.Rangespace
+    LinearSolverMethod.Rangespace,
+    LinearSolverMethod.Sparse,
+    LinearSolverMethod.Iterative,
+    LinearSolverMethod.Automatic
 ]
 
 @pytest.mark.parametrize("nx"     , tested_nx)
@@ -43,7 +48,9 @@ tested_methods = [
 @pytest.mark.parametrize("nu"     , tested_nu)
 @pytest.mark.parametrize("diagHxx", tested_diagHxx)
 @pytest.mark.parametrize("method" , tested_methods)
-def testLinearSolver(nx, np, ny, nz, nl, nu, diagHxx, method):
+@pytest.mark.parametrize("chol"   , tested_chol)
+@pytest.mark.parametrize("mixed"  , tested_mixed)
+def testLinearSolver(nx, np, ny, nz, nl, nu, diagHxx, method, chol, mixed):
 
     params = MasterParams(nx, np, ny, nz, nl, nu, diagHxx)
 
@@ -54,6 +61,12 @@ def testLinearSolver(nx, np, ny, nz, nl, nu, diagHxx, method):
     if method == LinearSolverMethod.Rangespace and not diagHxx:
         return  # Rangespace method onlf applicable to diagonal Hxx matrices
 
+    if chol and method != LinearSolverMethod.Nullspace:
+        return  # Cholesky decomposition only applicable to method Nullspace
+
+    if mixed and method not in [LinearSolverMethod.Fullspace, LinearSolverMethod.Nullspace]:
+        return  # Single-precision decomposition only applicable to methods Fullspace and Nullspace
+
     M = createMasterMatrix(params)
 
     nw = params.dims.nw
@@ -71,6 +84,8 @@ def testLinearSolver(nx, np, ny, nz, nl, nu, diagHxx, method):
 
     options = LinearSolverOptions()
     options.method = method
+    options.cholesky = chol
+    options.mixedprecision = mixed
 
     linearsolver = LinearSolver()
     linearsolver.setOptions(options)
@@ -85,3 +100,90 @@ def testLinearSolver(nx, np, ny, nz, nl, nu, diagHxx, method):
     ju = M.ju  # the indices of the unstable variables in x
 
     assert all(u.x[ju] == a.x[ju])  # ensure ux[ju] == ax[ju]
+
+    #==========================================================================
+    # Check the solution with the Hessian product function in method Iterative
+    #==========================================================================
+    if method == LinearSolverMethod.Iterative:
+        Hxx = npy.array(M.H.Hxx)
+
+        evals = { "hessian": 0 }  # the number of calls of the Hessian product function
+
+        def hessian(v, Hv):
+            Hv[:] = Hxx @ v
+            evals["hessian"] += 1
+
+        options.iterative.hessian = hessian
+        linearsolver.setOptions(options)
+
+        linearsolver.decompose(Mc)
+        linearsolver.solve(Mc, a, u)
+
+        assert evals["hessian"] > 0
+        assert_almost_equal( (M * u).array(), a.array() )
+
+        # Check the same with a diagonal approximation of Hxx in the master
+        # matrix, also when GMRES stops after one iteration so that the dense
+        # solver is used instead, which must use the exact Hxx as well
+        H = MatrixViewH(npy.diag(npy.diag(Hxx)), M.H.Hxp, False)
+        Mapprox = MasterMatrix(M.dims, H, M.V, M.W, M.RWQ, M.js, M.ju)
+
+        canonicalizer.update(Mapprox)
+
+        Mc = canonicalizer.canonicalMatrix()
+
+        for maxiters in [options.iterative.maxiters, 1]:
+            options.iterative.maxiters = maxiters
+            linearsolver.setOptions(options)
+
+            linearsolver.decompose(Mc)
+            linearsolver.solve(Mc, a, u)
+
+            assert_almost_equal( (M * u).array(), a.array() )
+
+        canonicalizer.update(M)
+
+        Mc = canonicalizer.canonicalMatrix()
+
+        options.iterative.maxiters = LinearSolverIterativeOptions().maxiters
+        options.iterative.hessian = None
+        linearsolver.setOptions(options)
+
+    #==========================================================================
+    # Check the solution after a new decomposition with only Hxx changed
+    #==========================================================================
+    H = MatrixViewH(2.0 * M.H.Hxx, M.H.Hxp, diagHxx)
+    M = MasterMatrix(M.dims, H, M.V, M.W, M.RWQ, M.js, M.ju)
+
+    a = M * uexp
+
+    canonicalizer.update(M)
+
+    Mc = canonicalizer.canonicalMatrix()
+
+    linearsolver.decompose(Mc)
+    linearsolver.solve(Mc, a, u)
+
+    assert_almost_equal( (M * u).array(), a.array() )
+
+    #==========================================================================
+    # Check the solution with the decomposition of the previous matrix after
+    # Hxx is slightly changed, as in the simplified Newton method, which must
+    # not be decomposed again in method Automatic because it is inaccurate
+    #==========================================================================
+    if method == LinearSolverMethod.Iterative:
+        return  # the matrix-free method always uses the current matrix
+
+    uprev = MasterVector(dims)
+    linearsolver.solve(Mc, a, uprev)
+
+    H = MatrixViewH(1.001 * M.H.Hxx, M.H.Hxp, diagHxx)
+    Mnew = MasterMatrix(M.dims, H, M.V, M.W, M.RWQ, M.js, M.ju)
+
+    canonicalizer.update(Mnew)
+
+    Mc = canonicalizer.canonicalMatrix()
+
+    linearsolver.solveWithPreviousDecomposition(Mc, a, u)
+
+    assert_almost_equal(u.array(), uprev.array())
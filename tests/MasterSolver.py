@@ -166,3 +166,28 @@ def testMasterSolver(nx, np, ny, nz, nl, nul, nuu, diagHxx):
     res = solver.solve(problem, state, sensitivity)
 
     assert res.succeeded
+
+    # Check the problem is solved again with updated vectors without processing its structure again
+    problem.b = 1.1 * (Ax @ cx + Ap @ cp)
+
+    expected = MasterState()
+    expected.u = MasterVector(dims)
+
+    res = solver.solve(problem, expected)
+
+    assert res.succeeded
+
+    problem.Ax = 2.0 * Ax  # resolve must ignore this change, since it uses the echelon form of Ax computed in the last solve
+
+    state = MasterState()
+    state.u = MasterVector(dims)
+
+    res = solver.resolve(problem, state)
+
+    assert res.succeeded
+    assert_array_almost_equal(state.u.x, expected.u.x)
+    assert_array_almost_equal(Ax @ state.u.x + Ap @ state.u.p, problem.b)
+
+    res = solver.resolve(problem, state, sensitivity)
+
+    assert res.succeeded
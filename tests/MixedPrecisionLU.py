@@ -0,0 +1,62 @@
+# Optima is a C++ library for numerical solution of linear and nonlinear programing problems.
+#
+# Copyright (C) 2020 Allan Leal
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program. If not, see <http://www.gnu.org/licenses/>.
+
+
+from testing.optima import *
+from testing.utils.matrices import *
+
+
+# Tested number of variables in x
+tested_n = [20, 40, 60]
+
+# Tested rank deficiency of matrix A
+tested_rank_deficiency = [0, 1, 5]
+
+
+@pytest.mark.parametrize("n", tested_n)
+@pytest.mark.parametrize("rank_deficiency", tested_rank_deficiency)
+def testMixedPrecisionLU(n, rank_deficiency):
+
+    x_expected = npy.linspace(1, n, n)
+
+    linearly_dependent_rows = list(range(1, n, math.ceil(n / rank_deficiency))) \
+        if rank_deficiency != 0 else []
+
+    A = matrix_non_singular(n)
+
+    # Change the rows of A so that linearly dependent rows are produced
+    for row in linearly_dependent_rows:
+        A[row, :] = row * A[0, :]
+
+    b = A @ x_expected
+
+    lu = MixedPrecisionLU()
+    lu.decompose(A)
+
+    x = npy.zeros(n)
+    lu.solve(b, x)
+
+    assert_allclose(A @ x, b)
+
+    # The refined solution of a non-singular matrix is as accurate as with a double-precision decomposition
+    if rank_deficiency == 0:
+        assert not lu.fallback()
+        assert_allclose(x, x_expected, rtol=1e-12)
+
+    # A singular matrix is decomposed in double precision instead
+    else:
+        assert lu.fallback()
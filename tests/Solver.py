@@ -206,3 +206,260 @@ def testMasterSolver(nx, np, ny, nz, nl, nul, nuu, diagHxx):
 
     assert_array_almost_equal(Ax @ xc + Ap @ pc, bec)
 
+    # Check a SolverSession produces the same states as a Solver, also after its data is updated
+    session = SolverSession(problem)
+    session.setOptions(options)
+
+    sstate = State(dims)
+
+    res = session.solve(sstate)
+
+    assert res.succeeded
+    assert_array_almost_equal(sstate.x, state.x)
+
+    problem.be = 1.1 * cy
+
+    res = solver.solve(problem, state)
+
+    assert res.succeeded
+
+    session.setbe(1.1 * cy)
+
+    res = session.solve(sstate)
+
+    assert res.succeeded
+    assert_array_almost_equal(sstate.x, state.x)
+
+    # Check the simplified Newton method, which reuses decompositions of the Jacobian matrix, produces the same states
+    options.newtonstep.simplified.active = True
+
+    solver.setOptions(options)
+
+    sstate = State(dims)
+
+    res = solver.solve(problem, sstate)
+
+    assert res.succeeded
+    assert_array_almost_equal(sstate.x, state.x)
+
+    # Check the same with method Automatic, which must not decompose again the reused Jacobian matrix
+    method = options.newtonstep.linearsolver.method
+
+    options.newtonstep.linearsolver.method = LinearSolverMethod.Automatic
+
+    solver.setOptions(options)
+
+    sstate = State(dims)
+
+    res = solver.solve(problem, sstate)
+
+    assert res.succeeded
+    assert_array_almost_equal(sstate.x, state.x)
+
+    options.newtonstep.linearsolver.method = method
+    options.newtonstep.simplified.active = False
+
+    # Check the quasi-Newton approximation of Hxx, started from the exact Hxx, produces the same states (not applicable with rangespace method)
+    if diagHxx: return
+
+    options.residualfunction.hessian = HessianMethod.QuasiNewton
+
+    solver.setOptions(options)
+
+    qstate = State(dims)
+
+    res = solver.solve(problem, qstate)
+
+    assert res.succeeded
+    assert_array_almost_equal(qstate.x, state.x)
+
+
+@pytest.mark.parametrize("nx"               , [10, 20, 50])
+@pytest.mark.parametrize("withp"            , [False, True])
+@pytest.mark.parametrize("hessianexactfirst", [False, True])
+@pytest.mark.parametrize("method"           , [LinearSolverMethod.Fullspace, LinearSolverMethod.Nullspace])
+def testSolverQuasiNewton(nx, withp, hessianexactfirst, method):
+
+    # The Gibbs energy minimization problem min sum(x*(g + ln(x))) subject to
+    # Ax = b and x > 0, and also sum(x) - p = 0 and p - nx = 0 if withp is
+    # true, whose Hessian 1/x varies by many orders of magnitude when some x
+    # approach their lower bounds during the iterations
+    ny = nx//10 + 1
+    np = 1 if withp else 0
+    nz = np
+
+    g = random.rand(nx)
+    A = random.rand(ny, nx)
+
+    evals = { "fxx": 0 }  # the number of evaluations of fxx
+
+    def objectivefn_f(res, x, p, c, opts):
+        res.f  = sum(x * (g + log(x)))
+        res.fx = g + log(x) + 1.0
+        if opts.eval.fxx:
+            res.fxx = diag(1.0/x)
+            res.diagfxx = True
+            evals["fxx"] += 1
+
+    def constraintfn_h(res, x, p, c, opts):
+        res.val = array([sum(x) - p[0]])
+        res.ddx = ones((1, nx))
+        res.ddp = -ones((1, 1))
+
+    def constraintfn_v(res, x, p, c, opts):
+        res.val = array([p[0] - nx])
+        res.ddx = zeros((1, nx))
+        res.ddp = ones((1, 1))
+
+    dims = Dims()
+    dims.x  = nx
+    dims.p  = np
+    dims.be = ny
+    dims.he = nz
+
+    problem = Problem(dims)
+    problem.f = objectivefn_f
+    problem.Aex = A
+    problem.be = A @ ones(nx)
+    problem.xlower = full(nx, 1e-14)
+    problem.xupper = full(nx, inf)
+
+    if withp:
+        problem.he = constraintfn_h
+        problem.v = constraintfn_v
+        problem.plower = full(np, -inf)
+        problem.pupper = full(np,  inf)
+
+    options = Options()
+    options.newtonstep.linearsolver.method = method
+
+    solver = Solver()
+    solver.setOptions(options)
+
+    state = State(dims)
+    state.x = ones(nx)
+    state.p = ones(np)
+
+    res = solver.solve(problem, state)
+
+    assert res.succeeded
+
+    # Check the quasi-Newton approximation of the Hessian converges to the same solution
+    options.residualfunction.hessian = HessianMethod.QuasiNewton
+    options.residualfunction.hessianexactfirst = hessianexactfirst
+
+    solver.setOptions(options)
+
+    qstate = State(dims)
+    qstate.x = ones(nx)
+    qstate.p = ones(np)
+
+    evals["fxx"] = 0
+
+    res = solver.solve(problem, qstate)
+
+    assert res.succeeded
+    assert_array_almost_equal(qstate.x, state.x)
+
+    if not hessianexactfirst:
+        assert evals["fxx"] == 0  # fxx is never requested from the objective function
+
+
+@pytest.mark.skipif(not PROFILING, reason="the evaluation counters in Result are collected only if Optima is compiled with OPTIMA_ENABLE_PROFILING")
+@pytest.mark.parametrize("withp"  , [False, True])
+@pytest.mark.parametrize("hessian", [HessianMethod.Exact, HessianMethod.QuasiNewton])
+def testSolverProfiling(withp, hessian):
+
+    # The Gibbs energy minimization problem of testSolverQuasiNewton, whose
+    # functions count their evaluations and the derivatives requested in them
+    nx = 20
+    ny = nx//10 + 1
+    np = 1 if withp else 0
+    nz = np
+
+    g = random.rand(nx)
+    A = random.rand(ny, nx)
+
+    evals = {}
+
+    def objectivefn_f(res, x, p, c, opts):
+        evals["f"]   += 1
+        evals["fxx"] += opts.eval.fxx
+        evals["fxp"] += opts.eval.fxp
+        res.f  = sum(x * (g + log(x)))
+        res.fx = g + log(x) + 1.0
+        if opts.eval.fxx:
+            res.fxx = diag(1.0/x)
+            res.diagfxx = True
+
+    def constraintfn_h(res, x, p, c, opts):
+        evals["h"]  += 1
+        evals["hx"] += opts.eval.ddx
+        evals["hp"] += opts.eval.ddp
+        res.val = array([sum(x) - p[0]])
+        res.ddx = ones((1, nx))
+        res.ddp = -ones((1, 1))
+
+    def constraintfn_v(res, x, p, c, opts):
+        evals["v"]  += 1
+        evals["vx"] += opts.eval.ddx
+        evals["vp"] += opts.eval.ddp
+        res.val = array([p[0] - nx])
+        res.ddx = zeros((1, nx))
+        res.ddp = ones((1, 1))
+
+    dims = Dims()
+    dims.x  = nx
+    dims.p  = np
+    dims.be = ny
+    dims.he = nz
+
+    problem = Problem(dims)
+    problem.f = objectivefn_f
+    problem.Aex = A
+    problem.be = A @ ones(nx)
+    problem.xlower = full(nx, 1e-14)
+    problem.xupper = full(nx, inf)
+
+    if withp:
+        problem.he = constraintfn_h
+        problem.v = constraintfn_v
+        problem.plower = full(np, -inf)
+        problem.pupper = full(np,  inf)
+
+    options = Options()
+    options.residualfunction.hessian = hessian
+    options.residualfunction.hessianexactfirst = False
+
+    solver = Solver()
+    solver.setOptions(options)
+
+    state = State(dims)
+    state.x = ones(nx)
+    state.p = ones(np)
+
+    evals.update({ "f": 0, "fxx": 0, "fxp": 0, "h": 0, "hx": 0, "hp": 0, "v": 0, "vx": 0, "vp": 0 })
+
+    res = solver.solve(problem, state)
+
+    assert res.succeeded
+
+    # Check the counters in Result match the evaluations seen by the functions
+    assert res.num_objective_evals     == evals["f"]
+    assert res.num_objective_evals_f   == evals["f"]
+    assert res.num_objective_evals_fx  == evals["f"]
+    assert res.num_objective_evals_fxx == evals["fxx"]
+    assert res.num_objective_evals_fxp == evals["fxp"]
+    assert res.num_constraint_evals_h  == evals["h"]
+    assert res.num_constraint_evals_hx == evals["hx"]
+    assert res.num_constraint_evals_hp == evals["hp"]
+    assert res.num_constraint_evals_v  == evals["v"]
+    assert res.num_constraint_evals_vx == evals["vx"]
+    assert res.num_constraint_evals_vp == evals["vp"]
+
+    assert res.num_objective_evals_f > 0
+
+    if hessian == HessianMethod.QuasiNewton:
+        assert res.num_objective_evals_fxx == 0  # so that the counters of f and fxx are indeed distinct
+    else:
+        assert res.num_objective_evals_fxx > 0